@@ -31,6 +31,7 @@
 #ifndef CPPA_ACTOR_HPP
 #define CPPA_ACTOR_HPP
 
+#include <atomic>
 #include <memory>
 #include <cstdint>
 #include <type_traits>
@@ -47,6 +48,8 @@ namespace cppa {
 class serializer;
 class deserializer;
 
+namespace detail { class actor_registry; }
+
 /**
  * @brief A unique actor ID.
  * @relates actor
@@ -165,6 +168,14 @@ class actor : public channel {
      */
     inline bool is_proxy() const;
 
+    /**
+     * @brief Checks whether this actor has an entry in the actor registry,
+     *        i.e., whether it was published or serialized before.
+     * @returns @c true if the registry already knows this actor;
+     *          otherwise @c false.
+     */
+    inline bool is_registered() const;
+
 
  protected:
 
@@ -174,8 +185,11 @@ class actor : public channel {
 
  private:
 
+    friend class detail::actor_registry;
+
     actor_id m_id;
     bool m_is_proxy;
+    std::atomic<bool> m_is_registered;
 
 };
 
@@ -202,6 +216,10 @@ inline bool actor::is_proxy() const {
     return m_is_proxy;
 }
 
+inline bool actor::is_registered() const {
+    return m_is_registered.load(std::memory_order_acquire);
+}
+
 template<typename T>
 bool actor::attach(std::unique_ptr<T>&& ptr,
                    typename std::enable_if<
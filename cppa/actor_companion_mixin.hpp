@@ -85,6 +85,7 @@ class actor_companion_mixin : public Base {
         m_self->m_current_node = msg.get();
         auto f = m_message_handler; // make sure ref count >= 2
         f(msg->msg);
+        m_self->flush_forward(msg.get());
     }
 
  private:
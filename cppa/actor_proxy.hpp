@@ -59,6 +59,16 @@ class actor_proxy : public enable_weak_ptr_mixin<actor> {
      */
     virtual void local_unlink_from(const actor_ptr& other) = 0;
 
+    /**
+     * @brief Delivers @p exit_msg, i.e., <tt>{'EXIT', reason}</tt>, of the
+     *        linked actor @p sender that just finished execution.
+     *
+     * Since @p sender cannot send any message afterwards, implementations
+     * may combine the exit messages to all proxies of one node.
+     * The default implementation calls <tt>enqueue(sender, exit_msg)</tt>.
+     */
+    virtual void link_exited(actor* sender, const any_tuple& exit_msg);
+
  protected:
 
     actor_proxy(actor_id mid);
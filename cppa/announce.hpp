@@ -35,6 +35,7 @@
 
 #include "cppa/uniform_type_info.hpp"
 #include "cppa/util/abstract_uniform_type_info.hpp"
+#include "cppa/detail/tuple_signature.hpp"
 #include "cppa/detail/default_uniform_type_info_impl.hpp"
 
 namespace cppa {
@@ -159,8 +160,12 @@ compound_member(const std::pair<GRes (Parent::*)() const,
  */
 template<typename T, typename... Args>
 inline bool announce(const Args&... args) {
-    return announce(typeid(T),
-                    new detail::default_uniform_type_info_impl<T>(args...));
+    auto result = announce(typeid(T),
+                           new detail::default_uniform_type_info_impl<T>(args...));
+    // allows the deserializer to create statically typed
+    // tuples for messages consisting of a single T
+    if (result) detail::tuple_signature<T>::register_signature();
+    return result;
 }
 
 /**
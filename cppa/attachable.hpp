@@ -36,6 +36,8 @@
 
 namespace cppa {
 
+class any_tuple;
+
 /**
  * @brief Callback utility class.
  */
@@ -77,6 +79,16 @@ class attachable {
      */
     virtual void actor_exited(std::uint32_t reason) = 0;
 
+    /**
+     * @brief Executed if the actor finished execution with given @p reason.
+     *
+     * The default implementation calls <tt>actor_exited(reason)</tt>.
+     * @param reason The exit rason of the observed actor.
+     * @param down_msg The tuple <tt>{'DOWN', reason}</tt>, shared among
+     *                 all @c attachable instances of the observed actor.
+     */
+    virtual void actor_exited(std::uint32_t reason, const any_tuple& down_msg);
+
     /**
      * @brief Selects a group of @c attachable instances by @p what.
      * @param what A value that selects zero or more @c attachable instances.
@@ -84,6 +96,15 @@ class attachable {
      */
     virtual bool matches(const token& what) = 0;
 
+    /**
+     * @brief Returns the @c ptr member of all tokens that might select
+     *        this instance or @c nullptr if any token might select it.
+     *
+     * Actors use this value as key to detach an instance in constant
+     * time. The default implementation returns @c nullptr.
+     */
+    virtual const void* token_ptr() const;
+
 };
 
 } // namespace cppa
@@ -98,6 +98,10 @@ class behavior {
         return m_impl == nullptr || m_impl->timeout().valid() == false;
     }
 
+    inline bool defined_at(const any_tuple& value) {
+        return (m_impl) && m_impl->defined_at(value);
+    }
+
     template<typename T>
     inline bool operator()(T&& arg) {
         return (m_impl) && m_impl->invoke(std::forward<T>(arg));
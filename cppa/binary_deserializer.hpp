@@ -63,6 +63,12 @@ class binary_deserializer : public deserializer {
                     primitive_variant* storage);
     void read_raw(size_t num_bytes, void* storage);
 
+    void read_raw_array(primitive_type ptype, size_t num, void* storage);
+
+    void read_members(size_t num,
+                      const primitive_type* ptypes,
+                      void* const* storage);
+
  private:
 
     const char* pos;
@@ -70,6 +70,12 @@ class binary_serializer : public serializer {
 
     void write_raw(size_t num_bytes, const void* data);
 
+    void write_raw_array(primitive_type ptype, size_t num, const void* values);
+
+    void write_members(size_t num,
+                       const primitive_type* ptypes,
+                       const void* const* values);
+
  private:
 
     util::buffer* m_sink;
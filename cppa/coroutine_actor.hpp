@@ -0,0 +1,125 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011, 2012                                                   *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation, either version 3 of the License                  *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+#ifndef CPPA_COROUTINE_ACTOR_HPP
+#define CPPA_COROUTINE_ACTOR_HPP
+
+#include "cppa/behavior.hpp"
+#include "cppa/event_based_actor.hpp"
+
+namespace cppa {
+
+namespace detail { class coroutine_continuation; }
+
+/**
+ * @brief Base class for actors written in a sequential, receive-based
+ *        style that do not need a stack of their own.
+ *
+ * The body of the actor is implemented in {@link run()}, enclosed in
+ * @p CPPA_CO_BEGIN() and @p CPPA_CO_END(). Each @p CPPA_CO_RECEIVE(...)
+ * suspends the actor until one of its handlers was invoked. Afterwards,
+ * @p run() is re-entered and continues right after the receive statement.
+ * The actor quits with reason {@link exit_reason::normal normal} as soon
+ * as it reaches @p CPPA_CO_END().
+ * @warning Local variables of @p run() do not survive a receive statement
+ *          and must not be declared between two receive statements of the
+ *          same scope. Store all state in member variables instead.
+ *          Handlers must not call @p become() or @p unbecome().
+ */
+class coroutine_actor : public event_based_actor {
+
+    friend class detail::coroutine_continuation;
+
+    typedef event_based_actor super;
+
+ public:
+
+    /**
+     * @brief Overrides {@link event_based_actor::init()} and runs
+     *        the actor until its first receive statement.
+     */
+    void init(); //override
+
+    scheduled_actor_type impl_type(); //override
+
+ protected:
+
+    coroutine_actor();
+
+    /**
+     * @brief The sequential body of this actor.
+     */
+    virtual void run() = 0;
+
+    /**
+     * @brief Suspends the actor until a message matched by @p arg0
+     *        and @p args was handled or the timeout occurred.
+     * @note Use @p CPPA_CO_RECEIVE(...) instead of calling this directly.
+     */
+    template<typename Arg0, typename... Args>
+    inline void co_receive(const Arg0& arg0, const Args&... args) {
+        do_co_receive(match_expr_convert(arg0, args...));
+    }
+
+    /**
+     * @brief Resume point of {@link run()}, managed by the
+     *        @p CPPA_CO_* macros.
+     */
+    int m_co_state;
+
+ private:
+
+    void do_co_receive(behavior bhvr);
+
+    void continue_run();
+
+};
+
+} // namespace cppa
+
+#define CPPA_CO_BEGIN() switch (this->m_co_state) { case 0:
+
+// each receive statement gets a unique resume point per translation unit,
+// i.e., several receive statements may share a single line or macro;
+// resume points start at 1, because 0 is the resume point of CPPA_CO_BEGIN
+#define CPPA_CO_RECEIVE(...)                                                  \
+    CPPA_CO_RECEIVE_IMPL(__COUNTER__ + 1, __VA_ARGS__)
+
+#define CPPA_CO_RECEIVE_IMPL(resume_point, ...)                               \
+    do {                                                                      \
+        this->m_co_state = resume_point;                                      \
+        this->co_receive(__VA_ARGS__);                                        \
+        return;                                                               \
+        case resume_point: ;                                                  \
+    } while (false)
+
+#define CPPA_CO_END() } this->m_co_state = -1; this->quit()
+
+#endif // CPPA_COROUTINE_ACTOR_HPP
@@ -57,12 +57,14 @@
 #include "cppa/local_actor.hpp"
 #include "cppa/message_future.hpp"
 #include "cppa/response_handle.hpp"
+#include "cppa/coroutine_actor.hpp"
 #include "cppa/scheduled_actor.hpp"
 #include "cppa/scheduling_hint.hpp"
 #include "cppa/event_based_actor.hpp"
 
 #include "cppa/util/rm_ref.hpp"
 #include "cppa/network/acceptor.hpp"
+#include "cppa/network/coalescing_policy.hpp"
 
 #include "cppa/detail/memory.hpp"
 #include "cppa/detail/actor_count.hpp"
@@ -435,6 +437,9 @@ inline void send_tpl_impl(T* whom, Args&&... what) {
  * @brief Sends @p what as a message to @p whom.
  * @param whom Receiver of the message.
  * @param what Message content as tuple.
+ * @note Use <tt>send_tuple(whom, std::move(what))</tt> to hand the tuple
+ *       over to @p whom without copying it. The receiver then holds
+ *       the only reference and can modify the message in place.
  */
 template<class C, typename... Args>
 inline typename std::enable_if<std::is_base_of<channel, C>::value>::type
@@ -578,6 +583,10 @@ inline void reply_tuple_to(const response_handle& handle, any_tuple what) {
 
 /**
  * @brief Forwards the last received message to @p whom.
+ *
+ * The message is moved to @p whom as soon as the current callback
+ * returns, i.e., a receiver that modifies the message does not need
+ * to copy it as long as no other actor holds a reference to it.
  */
 inline void forward_to(const actor_ptr& whom) {
     self->forward_message(whom);
@@ -594,7 +603,7 @@ template<class Rep, class Period, typename... Args>
 inline void delayed_send_tuple(const channel_ptr& whom,
                                const std::chrono::duration<Rep,Period>& rtime,
                                any_tuple what) {
-    if (whom) get_scheduler()->delayed_send(whom, rtime, what);
+    if (whom) get_scheduler()->delayed_send(whom, rtime, std::move(what));
 }
 
 /**
@@ -751,6 +760,42 @@ actor_ptr spawn(Args&&... args) {
     return get_scheduler()->spawn(ptr);
 }
 
+/**
+ * @brief Spawns @p num actors of type @p ActorImpl at once.
+ *
+ * Cheaper than calling {@link spawn()} @p num times, since the
+ * scheduler updates its shared state only once for all actors.
+ * @param num Number of actors.
+ * @param args Constructor arguments, passed to each instance.
+ * @tparam ActorImpl Subtype of {@link event_based_actor} or {@link sb_actor}.
+ * @returns The spawned actors.
+ */
+template<class ActorImpl, typename... Args>
+std::vector<actor_ptr> spawn_batch(size_t num, const Args&... args) {
+    std::vector<scheduled_actor*> actors;
+    actors.reserve(num);
+    for (size_t i = 0; i < num; ++i) {
+        actors.push_back(detail::memory::create<ActorImpl>(args...));
+    }
+    return get_scheduler()->spawn_batch(actors);
+}
+
+/**
+ * @brief Spawns an actor of type @p ActorImpl that prefers
+ *        to run on the NUMA node @p node.
+ * @param node Index of the NUMA node, see
+ *             {@link scheduled_actor::node_affinity(int)}.
+ * @param args Optional constructor arguments.
+ * @tparam ActorImpl Subtype of {@link event_based_actor} or {@link sb_actor}.
+ * @returns An {@link actor_ptr} to the spawned {@link actor}.
+ */
+template<class ActorImpl, typename... Args>
+actor_ptr spawn_on_node(int node, Args&&... args) {
+    auto ptr = detail::memory::create<ActorImpl>(std::forward<Args>(args)...);
+    ptr->node_affinity(node);
+    return get_scheduler()->spawn(ptr);
+}
+
 /**
  * @brief Spawns an actor of type @p ActorImpl that joins @p grp immediately.
  * @param grp The group that the newly created actor shall join.
@@ -843,6 +888,23 @@ inline actor_ptr remote_actor(const std::string& host, std::uint16_t port) {
  */
 actor_ptr remote_actor(network::io_stream_ptr_pair connection);
 
+/**
+ * @brief Sets the policy for coalescing messages to remote actors,
+ *        i.e., how many messages each connection collects before
+ *        writing them to its socket.
+ * @note By default, each message is written immediately.
+ */
+void set_coalescing_policy(const network::coalescing_policy& policy);
+
+/**
+ * @brief Writes all messages to the node of @p whom immediately, ignoring
+ *        the coalescing policy. Includes all messages previously sent
+ *        to @p whom by the calling actor.
+ * @param whom An {@link actor_ptr} to a remote actor. This function has no
+ *             effect if @p whom is not a remote actor.
+ */
+void flush_remote(const actor_ptr& whom);
+
 /**
  * @brief Destroys all singletons, disconnects all peers and stops the
  *        scheduler. It is recommended to use this function as very last
@@ -125,6 +125,34 @@ class deserializer {
      */
     virtual void read_raw(size_t num_bytes, void* storage) = 0;
 
+    /**
+     * @brief Reads @p num values of type @p ptype into the contiguous
+     *        memory block @p storage, i.e., the counterpart
+     *        of {@link serializer::write_raw_array()}.
+     * @param ptype Type of each element in @p storage.
+     * @param num Number of elements in @p storage.
+     * @param storage An array of size @p num.
+     * @note The default implementation calls {@link read_value()}
+     *       for each element.
+     */
+    virtual void read_raw_array(primitive_type ptype,
+                                size_t num,
+                                void* storage);
+
+    /**
+     * @brief Reads @p num values, where <tt>storage[i]</tt> points to a
+     *        value of type <tt>ptypes[i]</tt>, i.e., the counterpart
+     *        of {@link serializer::write_members()}.
+     * @param num Size of the arrays @p ptypes and @p storage.
+     * @param ptypes Type of each element in @p storage.
+     * @param storage Pointers to the values.
+     * @note The default implementation calls {@link read_value()}
+     *       for each element.
+     */
+    virtual void read_members(size_t num,
+                              const primitive_type* ptypes,
+                              void* const* storage);
+
     inline actor_addressing* addressing() { return m_addressing; }
 
  private:
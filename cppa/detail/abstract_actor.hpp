@@ -41,11 +41,14 @@
 #include <thread>
 #include <cstdint>
 #include <algorithm>
+#include <functional>
+#include <unordered_map>
 
 #include "cppa/atom.hpp"
 #include "cppa/actor.hpp"
 #include "cppa/local_actor.hpp"
 #include "cppa/attachable.hpp"
+#include "cppa/actor_proxy.hpp"
 #include "cppa/exit_reason.hpp"
 #include "cppa/detail/memory.hpp"
 #include "cppa/util/shared_spinlock.hpp"
@@ -84,6 +87,84 @@ class abstract_actor_base<Base, true> : public Base {
 
 };
 
+/*
+ * @brief Stores nullable values in insertion order and indexes
+ *        them by a key for lookups in constant time.
+ *
+ * Erasing a value leaves a gap in the vector that is skipped by
+ * for_each(); gaps are removed once they make up more than half
+ * of the vector, which keeps erase() amortized O(1).
+ */
+template<typename T>
+class insertion_ordered_index {
+
+    typedef std::unordered_multimap<const void*, size_t> index_type;
+
+ public:
+
+    inline bool empty() const { return m_index.empty(); }
+
+    inline bool contains(const void* key) const {
+        return m_index.count(key) > 0;
+    }
+
+    void insert(const void* key, T value) {
+        m_index.insert(std::make_pair(key, m_values.size()));
+        m_values.push_back(std::move(value));
+    }
+
+    // moves the first value stored under key that satisfies
+    // pred into storage and erases it
+    template<typename Predicate>
+    bool erase(const void* key, Predicate pred, T& storage) {
+        auto range = m_index.equal_range(key);
+        for (auto i = range.first; i != range.second; ++i) {
+            auto& value = m_values[i->second];
+            if (pred(value)) {
+                storage = std::move(value);
+                value.reset();
+                m_index.erase(i);
+                if (m_index.size() < m_values.size() / 2) compact();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // applies f to all values in insertion order
+    template<typename F>
+    void for_each(F f) {
+        for (auto& value : m_values) {
+            if (value) f(value);
+        }
+    }
+
+    void clear() {
+        m_values.clear();
+        m_index.clear();
+    }
+
+ private:
+
+    void compact() {
+        std::vector<size_t> positions(m_values.size());
+        size_t pos = 0;
+        for (size_t i = 0; i < m_values.size(); ++i) {
+            if (m_values[i]) {
+                positions[i] = pos;
+                if (i != pos) m_values[pos] = std::move(m_values[i]);
+                ++pos;
+            }
+        }
+        m_values.resize(pos);
+        for (auto& kvp : m_index) kvp.second = positions[kvp.second];
+    }
+
+    std::vector<T> m_values;
+    index_type m_index;
+
+};
+
 /*
  * @brief Implements linking and monitoring for actors.
  * @tparam Base Either {@link cppa::actor actor}
@@ -98,6 +179,9 @@ class abstract_actor : public abstract_actor_base<Base, std::is_base_of<local_ac
     typedef std::lock_guard<std::mutex> guard_type;
     typedef std::unique_ptr<attachable> attachable_ptr;
 
+    typedef insertion_ordered_index<actor_ptr> link_set;
+    typedef insertion_ordered_index<attachable_ptr> attachable_map;
+
  public:
 
     typedef detail::recursive_queue_node mailbox_element;
@@ -115,7 +199,8 @@ class abstract_actor : public abstract_actor_base<Base, std::is_base_of<local_ac
                 guard_type guard(m_mtx);
                 reason = m_exit_reason.load();
                 if (reason == exit_reason::not_exited) {
-                    m_attachables.push_back(std::move(uptr));
+                    auto key = uptr->token_ptr();
+                    m_attachables.insert(key, std::move(uptr));
                     return true;
                 }
             }
@@ -128,13 +213,14 @@ class abstract_actor : public abstract_actor_base<Base, std::is_base_of<local_ac
         attachable_ptr uptr;
         { // lifetime scope of guard
             guard_type guard(m_mtx);
-            auto end = m_attachables.end();
-            auto i = std::find_if(
-                        m_attachables.begin(), end,
-                        [&](attachable_ptr& p) { return p->matches(what); });
-            if (i != end) {
-                uptr = std::move(*i);
-                m_attachables.erase(i);
+            // attachables selected by tokens with the same ptr are looked up
+            // in constant time, all others are stored with key nullptr
+            auto pred = [&](const attachable_ptr& ptr) {
+                return ptr->matches(what);
+            };
+            if (!m_attachables.erase(what.ptr, pred, uptr)
+                    && what.ptr != nullptr) {
+                m_attachables.erase(nullptr, pred, uptr);
             }
         }
         // uptr will be destroyed here, without locked mutex
@@ -151,11 +237,7 @@ class abstract_actor : public abstract_actor_base<Base, std::is_base_of<local_ac
     bool remove_backlink(const intrusive_ptr<actor>& other) {
         if (other && other != this) {
             guard_type guard(m_mtx);
-            auto i = std::find(m_links.begin(), m_links.end(), other);
-            if (i != m_links.end()) {
-                m_links.erase(i);
-                return true;
-            }
+            return erase_link(other);
         }
         return false;
     }
@@ -166,11 +248,9 @@ class abstract_actor : public abstract_actor_base<Base, std::is_base_of<local_ac
             guard_type guard(m_mtx);
             reason = m_exit_reason.load();
             if (reason == exit_reason::not_exited) {
-                auto i = std::find(m_links.begin(), m_links.end(), other);
-                if (i == m_links.end()) {
-                    m_links.push_back(other);
-                    return true;
-                }
+                if (m_links.contains(other.get())) return false;
+                m_links.insert(other.get(), other);
+                return true;
             }
         }
         // send exit message without lock
@@ -215,12 +295,23 @@ class abstract_actor : public abstract_actor_base<Base, std::is_base_of<local_ac
             m_links.clear();
             m_attachables.clear();
         }
-        // send exit messages
-        for (actor_ptr& aptr : mlinks) {
-            aptr->enqueue(this, make_cow_tuple(atom("EXIT"), reason));
+        // all recipients share a single EXIT and a single DOWN message;
+        // proxies may combine the exit messages for a remote node
+        if (!mlinks.empty()) {
+            auto exit_msg = make_any_tuple(atom("EXIT"), reason);
+            mlinks.for_each([&](actor_ptr& aptr) {
+                if (aptr->is_proxy()) {
+                    auto pptr = static_cast<actor_proxy*>(aptr.get());
+                    pptr->link_exited(this, exit_msg);
+                }
+                else aptr->enqueue(this, exit_msg);
+            });
         }
-        for (attachable_ptr& ptr : mattachables) {
-            ptr->actor_exited(reason);
+        if (!mattachables.empty()) {
+            auto down_msg = make_any_tuple(atom("DOWN"), reason);
+            mattachables.for_each([&](attachable_ptr& ptr) {
+                ptr->actor_exited(reason, down_msg);
+            });
         }
     }
 
@@ -235,7 +326,7 @@ class abstract_actor : public abstract_actor_base<Base, std::is_base_of<local_ac
             // add link if not already linked to other
             // (checked by establish_backlink)
             else if (other->establish_backlink(this)) {
-                m_links.push_back(other);
+                m_links.insert(other.get(), other);
                 return true;
             }
         }
@@ -246,9 +337,9 @@ class abstract_actor : public abstract_actor_base<Base, std::is_base_of<local_ac
         guard_type guard(m_mtx);
         // remove_backlink returns true if this actor is linked to other
         if (other && !exited() && other->remove_backlink(this)) {
-            auto i = std::find(m_links.begin(), m_links.end(), other);
-            CPPA_REQUIRE(i != m_links.end());
-            m_links.erase(i);
+            auto erased = erase_link(other);
+            CPPA_REQUIRE(erased);
+            static_cast<void>(erased);
             return true;
         }
         return false;
@@ -256,6 +347,14 @@ class abstract_actor : public abstract_actor_base<Base, std::is_base_of<local_ac
 
  private:
 
+    // @pre m_mtx.locked()
+    bool erase_link(const intrusive_ptr<actor>& other) {
+        actor_ptr erased;
+        return m_links.erase(other.get(),
+                             [](const actor_ptr&) { return true; },
+                             erased);
+    }
+
     // @pre m_mtx.locked()
     bool exited() const {
         return m_exit_reason.load() != exit_reason::not_exited;
@@ -265,10 +364,11 @@ class abstract_actor : public abstract_actor_base<Base, std::is_base_of<local_ac
     std::atomic<std::uint32_t> m_exit_reason;
     // guards access to m_exited, m_subscriptions, and m_links
     std::mutex m_mtx;
-    // links to other actors
-    std::vector<actor_ptr> m_links;
-    // code that is executed on cleanup
-    std::vector<attachable_ptr> m_attachables;
+    // links to other actors in the order they were established
+    link_set m_links;
+    // code that is executed on cleanup in the order it was attached,
+    // indexed by attachable::token_ptr()
+    attachable_map m_attachables;
 
 };
 
@@ -40,6 +40,7 @@
 
 #include "cppa/util/type_list.hpp"
 
+#include "cppa/detail/pooled_memory.hpp"
 #include "cppa/detail/tuple_iterator.hpp"
 
 namespace cppa { namespace detail {
@@ -58,6 +59,15 @@ class abstract_tuple : public ref_counted {
     inline abstract_tuple(tuple_impl_info tii) : m_impl_type(tii) { }
     abstract_tuple(const abstract_tuple& other);
 
+    // all tuple implementations are allocated from pooled memory
+    static inline void* operator new(size_t size) {
+        return pooled_memory::allocate(size);
+    }
+
+    static inline void operator delete(void* ptr, size_t size) {
+        pooled_memory::deallocate(ptr, size);
+    }
+
     // mutators
     virtual void* mutable_at(size_t pos) = 0;
     virtual void* mutable_native_data();
@@ -36,6 +36,7 @@
 namespace cppa { namespace detail {
 
 void inc_actor_count();
+void inc_actor_count(size_t num);
 void dec_actor_count();
 
 /*
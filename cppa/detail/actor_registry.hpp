@@ -41,6 +41,7 @@
 #include "cppa/actor.hpp"
 #include "cppa/attachable.hpp"
 #include "cppa/util/shared_spinlock.hpp"
+#include "cppa/util/producer_consumer_list.hpp"
 
 #include "cppa/detail/singleton_mixin.hpp"
 
@@ -75,12 +76,22 @@ class actor_registry : public singleton_mixin<actor_registry> {
 
     void erase(actor_id key, std::uint32_t reason);
 
-    // gets the next free actor id
+    // gets the next free actor id; threads that called use_id_blocks()
+    // reserve blocks of IDs to avoid contention, i.e., IDs are unique
+    // but not consecutive
     actor_id next_id();
 
+    // makes next_id() reserve blocks of IDs for the calling thread;
+    // meant for long-lived threads such as scheduler workers only,
+    // since each thread wastes the remainder of its last block
+    void use_id_blocks();
+
     // increases running-actors-count by one
     void inc_running();
 
+    // increases running-actors-count by @p num
+    void inc_running(size_t num);
+
     // decreases running-actors-count by one
     void dec_running();
 
@@ -93,7 +104,28 @@ class actor_registry : public singleton_mixin<actor_registry> {
 
     typedef std::map<actor_id, value_type> entries;
 
-    std::atomic<size_t> m_running;
+    // one shard of the running-actors-count; increments and decrements
+    // are counted separately, because an actor might be counted by one
+    // thread and uncounted by another; padding on both ends keeps the
+    // counters of two shards on distinct cache lines even though
+    // m_running is not necessarily aligned to a cache line
+    struct running_shard {
+        char pad0[CPPA_CACHE_LINE_SIZE];
+        std::atomic<std::uint64_t> incs;
+        std::atomic<std::uint64_t> decs;
+        char pad1[CPPA_CACHE_LINE_SIZE - 2 * sizeof(std::atomic<std::uint64_t>)];
+    };
+
+    static constexpr size_t num_running_shards = 32;
+
+    running_shard& local_running_shard();
+
+    running_shard m_running[num_running_shards];
+    // number of threads in await_running_count_equal()
+    std::atomic<size_t> m_running_waiters;
+    // largest count any thread ever waited for; dec_running() notifies
+    // waiters only if the count dropped to this value or below
+    std::atomic<size_t> m_running_target;
     std::atomic<actor_id> m_ids;
 
     std::mutex m_running_mtx;
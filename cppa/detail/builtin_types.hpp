@@ -0,0 +1,115 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011, 2012                                                   *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation, either version 3 of the License                  *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+
+#ifndef CPPA_BUILTIN_TYPES_HPP
+#define CPPA_BUILTIN_TYPES_HPP
+
+#include <map>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <type_traits>
+
+#include "cppa/atom.hpp"
+#include "cppa/cppa_fwd.hpp"
+
+#include "cppa/util/type_list.hpp"
+
+namespace cppa { class process_information; }
+namespace cppa { namespace util { class duration; } }
+namespace cppa { namespace util { struct void_type; } }
+namespace cppa { namespace network { class message_header; } }
+
+namespace cppa { namespace detail {
+
+/**
+ * @brief Lists all types that are announced by libcppa itself in the
+ *        order of their type IDs, i.e., the type ID of an element is its
+ *        index in this list.
+ * @note The constructor of {@link uniform_type_info_map} inserts
+ *       all types in this order.
+ */
+typedef util::type_list<
+            std::int8_t,
+            std::int16_t,
+            std::int32_t,
+            std::int64_t,
+            std::uint8_t,
+            std::uint16_t,
+            std::uint32_t,
+            std::uint64_t,
+            float,
+            double,
+            long double,
+            std::string,
+            std::u16string,
+            std::u32string,
+            bool,
+            util::duration,
+            any_tuple,
+            actor_ptr,
+            group_ptr,
+            channel_ptr,
+            atom_value,
+            network::message_header,
+            util::void_type,
+            intrusive_ptr<process_information>,
+            std::map<std::string, std::string>,
+            std::vector<std::uint32_t>
+        >
+        builtin_types;
+
+constexpr int integer_type_index(bool is_signed, size_t size) {
+    return size == 1 ? (is_signed ? 0 : 4)
+         : size == 2 ? (is_signed ? 1 : 5)
+         : size == 4 ? (is_signed ? 2 : 6)
+         : size == 8 ? (is_signed ? 3 : 7)
+         : -1;
+}
+
+// integers are mapped by size and signedness, since e.g. both long
+// and long long are 64 bit signed integers on most platforms
+template<typename T,
+         bool IsInteger =    std::is_integral<T>::value
+                          && !std::is_same<T, bool>::value>
+struct builtin_type_id {
+    static constexpr int value = util::tl_find<builtin_types, T>::value;
+};
+
+template<typename T>
+struct builtin_type_id<T, true> {
+    static constexpr int value = integer_type_index(std::is_signed<T>::value,
+                                                    sizeof(T));
+};
+
+} } // namespace cppa::detail
+
+#endif // CPPA_BUILTIN_TYPES_HPP
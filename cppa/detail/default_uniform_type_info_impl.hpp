@@ -31,7 +31,9 @@
 #ifndef CPPA_DEFAULT_UNIFORM_TYPE_INFO_IMPL_HPP
 #define CPPA_DEFAULT_UNIFORM_TYPE_INFO_IMPL_HPP
 
+#include <vector>
 #include <memory>
+#include <algorithm>
 
 #include "cppa/anything.hpp"
 #include "cppa/serializer.hpp"
@@ -132,19 +134,32 @@ typedef std::integral_constant<int,0> primitive_impl;
 typedef std::integral_constant<int,1> list_impl;
 typedef std::integral_constant<int,2> map_impl;
 typedef std::integral_constant<int,3> pair_impl;
+typedef std::integral_constant<int,4> raw_array_impl;
 typedef std::integral_constant<int,9> recursive_impl;
 
+// vectors of arithmetic primitives are (de)serialized as a whole
+template<typename T>
+struct is_raw_array : std::false_type { };
+
+template<typename T, class Allocator>
+struct is_raw_array<std::vector<T, Allocator> > {
+    static constexpr bool value =    std::is_arithmetic<T>::value
+                                  && util::is_primitive<T>::value;
+};
+
 template<typename T>
 constexpr int impl_id() {
     return util::is_primitive<T>::value
            ? 0
-           : (is_stl_compliant_list<T>::value
-              ? 1
-              : (is_stl_compliant_map<T>::value
-                 ? 2
-                 : (is_stl_pair<T>::value
-                    ? 3
-                    : 9)));
+           : (is_raw_array<T>::value
+              ? 4
+              : (is_stl_compliant_list<T>::value
+                 ? 1
+                 : (is_stl_compliant_map<T>::value
+                    ? 2
+                    : (is_stl_pair<T>::value
+                       ? 3
+                       : 9))));
 }
 
 template<typename T>
@@ -192,6 +207,16 @@ class default_serialize_policy {
         s->end_sequence();
     }
 
+    template<typename T>
+    void simpl(const T& val, serializer* s, raw_array_impl) const {
+        typedef typename T::value_type value_type;
+        s->begin_sequence(val.size());
+        s->write_raw_array(type_to_ptype<value_type>::ptype,
+                           val.size(),
+                           val.data());
+        s->end_sequence();
+    }
+
     template<typename T>
     void simpl(const T& val, serializer* s, map_impl) const {
         // lists and maps share code for serialization
@@ -228,6 +253,26 @@ class default_serialize_policy {
         d->end_sequence();
     }
 
+    template<typename T>
+    void dimpl(T& storage, deserializer* d, raw_array_impl) const {
+        // grows storage stepwise to not trust the sequence size
+        // of a (possibly corrupted) data source blindly
+        static constexpr size_t max_step = 4096;
+        typedef typename T::value_type value_type;
+        storage.clear();
+        size_t remaining = d->begin_sequence();
+        while (remaining > 0) {
+            auto n = std::min(remaining, max_step);
+            auto pos = storage.size();
+            storage.resize(pos + n);
+            d->read_raw_array(type_to_ptype<value_type>::ptype,
+                              n,
+                              storage.data() + pos);
+            remaining -= n;
+        }
+        d->end_sequence();
+    }
+
     template<typename T>
     void dimpl(T& storage, deserializer* d, map_impl) const {
         storage.clear();
@@ -426,11 +471,117 @@ unique_uti new_member_tinfo(GRes (C::*getter)() const, SRes (C::*setter)(SArg),
     return unique_uti(new result_type(access_policy(getter, setter), std::move(meminf)));
 }
 
+// a member is "flat" if it is an integer or a string, i.e.,
+// if the binary format stores it without any type information
+template<typename T>
+struct is_flat_member {
+    static constexpr bool value =    (   std::is_integral<T>::value
+                                      && util::is_primitive<T>::value)
+                                  || std::is_same<T, std::string>::value;
+};
+
+// checks whether all Ts are pointers to flat members of C
+template<class C, typename... Ts>
+struct all_flat_members : std::true_type { };
+
+template<class C, typename T, typename... Ts>
+struct all_flat_members<C, T, Ts...> : std::false_type { };
+
+template<class C, typename R, typename... Ts>
+struct all_flat_members<C, R C::*, Ts...> {
+    static constexpr bool value =    is_flat_member<R>::value
+                                  && all_flat_members<C, Ts...>::value;
+};
+
+// compile-time list of member pointers to flat members
+template<class C, typename... Rs>
+class flat_members {
+
+ public:
+
+    template<typename Pointer, typename Object>
+    inline void addresses(Object&, Pointer*) const { }
+
+};
+
+template<class C, typename R, typename... Rs>
+class flat_members<C, R, Rs...> {
+
+ public:
+
+    template<typename... Ts>
+    flat_members(R C::* head, Ts... tail) : m_head(head), m_tail(tail...) { }
+
+    // stores the address of each member of obj in out
+    template<typename Pointer, typename Object>
+    inline void addresses(Object& obj, Pointer* out) const {
+        *out = &(obj.*m_head);
+        m_tail.addresses(obj, out + 1);
+    }
+
+ private:
+
+    R C::* m_head;
+    flat_members<C, Rs...> m_tail;
+
+};
+
+// (de)serializes all members of T using a single virtual call
+// to serializer::write_members / deserializer::read_members
+// if all members are flat
+template<typename T, typename... Rs>
+class flat_member_tinfo : public util::abstract_uniform_type_info<T> {
+
+    static constexpr size_t num_members = sizeof...(Rs);
+
+ public:
+
+    flat_member_tinfo(Rs T::*... memptrs) : m_members(memptrs...) { }
+
+    void serialize(const void* vptr, serializer* s) const {
+        static constexpr primitive_type ptypes[] = {
+            type_to_ptype<Rs>::ptype...
+        };
+        const void* values[num_members];
+        m_members.addresses(*reinterpret_cast<const T*>(vptr), values);
+        s->write_members(num_members, ptypes, values);
+    }
+
+    void deserialize(void* vptr, deserializer* d) const {
+        static constexpr primitive_type ptypes[] = {
+            type_to_ptype<Rs>::ptype...
+        };
+        void* storage[num_members];
+        m_members.addresses(*reinterpret_cast<T*>(vptr), storage);
+        d->read_members(num_members, ptypes, storage);
+    }
+
+ private:
+
+    flat_members<T, Rs...> m_members;
+
+};
+
+template<class C, typename... Rs>
+unique_uti new_flat_member_tinfo(Rs C::*... memptrs) {
+    return unique_uti(new flat_member_tinfo<C, Rs...>(memptrs...));
+}
+
 template<typename T>
 class default_uniform_type_info_impl : public util::abstract_uniform_type_info<T> {
 
     std::vector<unique_uti> m_members;
 
+    template<typename... Args>
+    void init(std::true_type, Args&&... args) {
+        m_members.push_back(new_flat_member_tinfo<T>(args...));
+    }
+
+    template<typename... Args>
+    void init(std::false_type, Args&&... args) {
+        push_back(std::forward<Args>(args)...);
+    }
+
     // terminates recursion
     inline void push_back() { }
 
@@ -471,7 +622,10 @@ class default_uniform_type_info_impl : public util::abstract_uniform_type_info<T
 
     template<typename... Args>
     default_uniform_type_info_impl(Args&&... args) {
-        push_back(std::forward<Args>(args)...);
+        typedef all_flat_members<T, typename util::rm_ref<Args>::type...>
+                flat_check;
+        std::integral_constant<bool, flat_check::value> token;
+        init(token, std::forward<Args>(args)...);
     }
 
     default_uniform_type_info_impl() {
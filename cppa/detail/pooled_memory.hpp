@@ -0,0 +1,80 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011, 2012                                                   *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation, either version 3 of the License                  *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+#ifndef CPPA_POOLED_MEMORY_HPP
+#define CPPA_POOLED_MEMORY_HPP
+
+#include <cstddef>
+
+namespace cppa { namespace detail {
+
+/**
+ * @brief Size class based memory pool for small objects such as tuples.
+ *
+ * Each thread caches released blocks per size class. Surplus blocks are
+ * moved in batches to a central free list shared by all threads, where
+ * other threads pick them up again, i.e., a block released by the
+ * receiver of a message is reused by the sender of the next one.
+ */
+class pooled_memory {
+
+    pooled_memory() = delete;
+
+ public:
+
+    /**
+     * @brief Blocks of up to @p max_block_size bytes are pooled,
+     *        larger allocations are forwarded to <tt>operator new</tt>.
+     */
+    static constexpr size_t max_block_size = 256;
+
+    struct counters {
+        // number of blocks allocated with operator new
+        size_t system_allocations;
+        // number of blocks released with operator delete
+        size_t system_deallocations;
+        // number of batches moved between thread caches and central lists
+        size_t central_transfers;
+    };
+
+    static void* allocate(size_t size);
+
+    static void deallocate(void* ptr, size_t size);
+
+    /**
+     * @brief Returns the current values of all counters (process wide).
+     */
+    static counters statistics();
+
+};
+
+} } // namespace cppa::detail
+
+#endif // CPPA_POOLED_MEMORY_HPP
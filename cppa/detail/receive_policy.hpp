@@ -207,6 +207,19 @@ class receive_policy {
         CPPA_CRITICAL("handle_timeout(partial_function&)");
     }
 
+    // invokes fun and moves the message to its new receiver afterwards
+    // if the callback used forward_to(), even if the callback throws
+    template<class Client, class Fun>
+    inline bool invoke_handler(Client* client, pointer node, Fun& fun) {
+        struct flush_guard {
+            Client* client;
+            pointer node;
+            ~flush_guard() { client->flush_forward(node); }
+        };
+        flush_guard guard{client, node};
+        return fun(node->msg);
+    }
+
     enum filter_result {
         normal_exit_signal,
         non_normal_exit_signal,
@@ -354,12 +367,12 @@ class receive_policy {
                 if (awaited_response.valid() && node->mid == awaited_response) {
                     auto previous_node = hm_begin(client, node, policy);
 #                   ifdef CPPA_DEBUG
-                    if (!fun(node->msg)) {
+                    if (!invoke_handler(client, node, fun)) {
                         std::cerr << "WARNING: actor didn't handle a "
                                      "synchronous message\n";
                     }
 #                   else
-                    fun(node->msg);
+                    invoke_handler(client, node, fun);
 #                   endif
                     client->mark_arrived(awaited_response);
                     client->remove_handler(awaited_response);
@@ -371,7 +384,7 @@ class receive_policy {
             case ordinary_message: {
                 if (!awaited_response.valid()) {
                     auto previous_node = hm_begin(client, node, policy);
-                    if (fun(node->msg)) {
+                    if (invoke_handler(client, node, fun)) {
                         // make sure synchronous request
                         // always receive a response
                         auto id = node->mid;
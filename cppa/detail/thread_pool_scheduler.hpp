@@ -31,7 +31,10 @@
 #ifndef CPPA_THREAD_POOL_SCHEDULER_HPP
 #define CPPA_THREAD_POOL_SCHEDULER_HPP
 
+#include <atomic>
+#include <memory>
 #include <thread>
+#include <vector>
 
 #include "cppa/scheduler.hpp"
 #include "cppa/context_switching_actor.hpp"
@@ -51,7 +54,18 @@ class thread_pool_scheduler : public scheduler {
 
     thread_pool_scheduler();
 
-    thread_pool_scheduler(size_t num_worker_threads);
+    // default maximum number of threads for blocking_io actors
+    static constexpr size_t default_max_io_threads = 64;
+
+    // default number of idle threads for blocking_io actors
+    // that are kept alive until the scheduler is destroyed
+    static constexpr size_t default_min_io_threads = 0;
+
+    thread_pool_scheduler(size_t num_worker_threads,
+                          size_t max_io_threads = default_max_io_threads,
+                          size_t min_io_threads = default_min_io_threads);
+
+    ~thread_pool_scheduler();
 
     void initialize() /*override*/;
 
@@ -66,6 +80,9 @@ class thread_pool_scheduler : public scheduler {
                     init_callback init_cb,
                     scheduling_hint hint);
 
+    std::vector<actor_ptr> spawn_batch(const std::vector<scheduled_actor*>& what,
+                                       scheduling_hint hint);
+
     actor_ptr spawn(void_function fun,
                     scheduling_hint hint);
 
@@ -79,16 +96,29 @@ class thread_pool_scheduler : public scheduler {
     typedef util::producer_consumer_list<scheduled_actor> job_queue;
 
     size_t m_num_threads;
-    job_queue m_queue;
+    // CPUs of each NUMA node
+    std::vector<std::vector<int> > m_nodes;
+    // one job queue per NUMA node
+    std::vector<std::unique_ptr<job_queue> > m_queues;
+    // round-robin index for jobs enqueued by non-worker threads
+    std::atomic<size_t> m_next_queue;
     scheduled_actor_dummy m_dummy;
     std::thread m_supervisor;
+    // runs actors spawned with the blocking_io hint
+    struct io_pool;
+    std::unique_ptr<io_pool> m_io_pool;
 
     static void worker_loop(worker*);
-    static void supervisor_loop(job_queue*, scheduled_actor*, size_t);
+    static void supervisor_loop(thread_pool_scheduler*);
+
+    void init_queues();
+
+    void push_job(scheduled_actor* what);
 
     actor_ptr spawn_impl(scheduled_actor_ptr what);
 
-    actor_ptr spawn_as_thread(void_function fun, init_callback cb, bool hidden);
+    actor_ptr spawn_as_thread(void_function fun, init_callback cb,
+                              bool hidden, bool blocking_io = false);
 
 };
 
@@ -0,0 +1,171 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011, 2012                                                   *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation, either version 3 of the License                  *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+#ifndef CPPA_TUPLE_SIGNATURE_HPP
+#define CPPA_TUPLE_SIGNATURE_HPP
+
+#include <vector>
+#include <cstddef>
+#include <typeinfo>
+#include <type_traits>
+
+#include "cppa/object.hpp"
+#include "cppa/anything.hpp"
+
+#include "cppa/util/type_list.hpp"
+
+#include "cppa/detail/tuple_vals.hpp"
+
+namespace cppa { class uniform_type_info; }
+
+namespace cppa { namespace detail {
+
+class abstract_tuple;
+
+/**
+ * @brief Creates a statically typed tuple by moving all values
+ *        out of the given (deserialized) objects.
+ */
+typedef abstract_tuple* (*tuple_factory)(std::vector<object>&);
+
+// note: both functions are implemented in uniform_type_info.cpp
+
+/**
+ * @brief Registers @p factory for the type signature @p types.
+ * @returns @c false if at least one type is not announced, @c true otherwise.
+ * @note Signatures containing types that are not announced yet become
+ *       known as soon as all of their types are announced.
+ */
+bool register_tuple_signature(const std::type_info** types,
+                              size_t size,
+                              tuple_factory factory);
+
+/**
+ * @brief Returns the factory for @p signature or @c nullptr
+ *        if @p signature is unknown.
+ */
+tuple_factory tuple_signature_factory(const std::vector<const uniform_type_info*>& signature);
+
+template<class Result, class Remaining>
+struct tuple_signature_factory_helper;
+
+template<class Result>
+struct tuple_signature_factory_helper<Result, util::empty_type_list> {
+    template<typename... Args>
+    static abstract_tuple* create(std::vector<object>&, Args&&... args) {
+        return new Result(std::forward<Args>(args)...);
+    }
+};
+
+template<class Result, typename T, typename... Ts>
+struct tuple_signature_factory_helper<Result, util::type_list<T, Ts...>> {
+    typedef tuple_signature_factory_helper<Result, util::type_list<Ts...>>
+            next;
+    template<typename... Args>
+    static abstract_tuple* create(std::vector<object>& src, Args&&... args) {
+        return next::create(src,
+                            std::forward<Args>(args)...,
+                            std::move(get_ref<T>(src[sizeof...(Args)])));
+    }
+};
+
+/**
+ * @brief Makes the signature <tt>{Ts...}</tt> known to the deserializer
+ *        of {@link any_tuple}, which then creates a <tt>tuple_vals<Ts...></tt>
+ *        instead of a dynamically typed tuple for incoming messages.
+ */
+template<typename... Ts>
+struct tuple_signature {
+
+    static abstract_tuple* create(std::vector<object>& elements) {
+        typedef tuple_signature_factory_helper<tuple_vals<Ts...>,
+                                               util::type_list<Ts...>>
+                helper;
+        return helper::create(elements);
+    }
+
+    static bool register_signature() {
+        const std::type_info* types[] = { &typeid(Ts)... };
+        return register_tuple_signature(types, sizeof...(Ts), &create);
+    }
+
+    // registers the signature on first call only; types
+    // that are not announced yet are resolved on announce
+    static bool register_once() {
+        static bool result = register_signature();
+        return result;
+    }
+
+};
+
+template<typename T>
+struct is_signature_element {
+    static constexpr bool value =
+               std::is_same<T, typename std::decay<T>::type>::value
+            && !std::is_same<T, anything>::value
+            && std::is_move_constructible<T>::value;
+};
+
+template<class Pattern, bool Registrable = (Pattern::size > 0)
+                                        && util::tl_forall<
+                                               Pattern,
+                                               is_signature_element
+                                           >::value>
+struct register_tuple_signature_of {
+    static inline void _() { }
+};
+
+template<typename... Ts>
+struct register_tuple_signature_of<util::type_list<Ts...>, true> {
+    static inline void _() {
+        tuple_signature<Ts...>::register_once();
+    }
+};
+
+// registers the signatures of all patterns without wildcards in Cases
+template<class Cases>
+struct register_tuple_signatures;
+
+template<>
+struct register_tuple_signatures<util::empty_type_list> {
+    static inline bool _() { return true; }
+};
+
+template<class Case, class... Cases>
+struct register_tuple_signatures<util::type_list<Case, Cases...>> {
+    static inline bool _() {
+        register_tuple_signature_of<typename Case::pattern_type>::_();
+        return register_tuple_signatures<util::type_list<Cases...>>::_();
+    }
+};
+
+} } // namespace cppa::detail
+
+#endif // CPPA_TUPLE_SIGNATURE_HPP
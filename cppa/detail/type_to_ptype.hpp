@@ -32,6 +32,7 @@
 #define CPPA_TYPE_TO_PTYPE_HPP
 
 #include <string>
+#include <cstddef>
 #include <cstdint>
 #include <type_traits>
 
@@ -91,6 +92,21 @@ struct type_to_ptype {
 
 };
 
+// returns the size of a single element of an integer type or 0
+inline std::size_t integer_size(primitive_type ptype) {
+    switch (ptype) {
+        case pt_int8:
+        case pt_uint8:  return 1;
+        case pt_int16:
+        case pt_uint16: return 2;
+        case pt_int32:
+        case pt_uint32: return 4;
+        case pt_int64:
+        case pt_uint64: return 8;
+        default:        return 0;
+    }
+}
+
 } } // namespace cppa::detail
 
 #endif // CPPA_TYPE_TO_PTYPE_HPP
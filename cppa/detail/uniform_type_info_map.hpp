@@ -31,11 +31,20 @@
 #ifndef CPPA_UNIFORM_TYPE_INFO_MAP_HPP
 #define CPPA_UNIFORM_TYPE_INFO_MAP_HPP
 
+#include <map>
 #include <set>
+#include <atomic>
 #include <string>
+#include <vector>
+#include <cstdint>
+#include <typeinfo>
 #include <utility> // std::pair
+#include <unordered_map>
+
+#include "cppa/util/shared_spinlock.hpp"
 
 #include "cppa/detail/singleton_mixin.hpp"
+#include "cppa/detail/tuple_signature.hpp"
 #include "cppa/detail/default_uniform_type_info_impl.hpp"
 
 namespace cppa { class uniform_type_info; }
@@ -53,8 +62,10 @@ class uniform_type_info_map : public singleton_mixin<uniform_type_info_map> {
  public:
 
     typedef std::set<std::string> set_type;
-    typedef std::map<std::string, uniform_type_info*> uti_map_type;
+    typedef std::unordered_map<std::string, uniform_type_info*> uti_map_type;
     typedef std::map<int, std::pair<set_type, set_type> > int_map_type;
+    typedef std::vector<const uniform_type_info*> signature_type;
+    typedef std::map<signature_type, tuple_factory> signature_map_type;
 
     inline const int_map_type& int_names() const {
         return m_ints;
@@ -64,11 +75,31 @@ class uniform_type_info_map : public singleton_mixin<uniform_type_info_map> {
 
     const uniform_type_info* by_uniform_name(const std::string& name) const;
 
+    // lock-free
+    inline const uniform_type_info* by_id(std::uint32_t id) const {
+        if (id >= max_types) return nullptr;
+        auto chunk = m_by_id[id / id_chunk_size].load(std::memory_order_acquire);
+        return chunk ? chunk[id % id_chunk_size].load(std::memory_order_acquire)
+                     : nullptr;
+    }
+
+    // lock-free for all types that were looked up before
+    const uniform_type_info* by_type_info(const std::type_info& tinfo) const;
+
     std::vector<const uniform_type_info*> get_all() const;
 
     // NOT thread safe!
     bool insert(const std::set<std::string>& raw_names, uniform_type_info* uti);
 
+    // thread safe; signatures with types that are not announced yet
+    // are kept as pending and get inserted once all types are known
+    bool insert_signature(const std::type_info** types,
+                          size_t size,
+                          tuple_factory factory);
+
+    // thread safe
+    tuple_factory signature_factory(const signature_type& signature) const;
+
  private:
 
     // maps raw typeid names to uniform type informations
@@ -77,9 +108,58 @@ class uniform_type_info_map : public singleton_mixin<uniform_type_info_map> {
     // maps uniform names to uniform type informations
     uti_map_type m_by_uname;
 
+    static constexpr size_t id_chunk_size = 256;
+
+    static constexpr size_t max_id_chunks = 64;
+
+    static constexpr size_t max_types = id_chunk_size * max_id_chunks;
+
+    typedef std::atomic<const uniform_type_info*> id_slot;
+
+    // maps type IDs to uniform type informations; chunks are allocated
+    // on demand and never moved, i.e., readers do not need a lock
+    std::atomic<id_slot*> m_by_id[max_id_chunks];
+
+    // next unused type ID
+    std::uint32_t m_next_id;
+
+    struct tinfo_slot {
+        std::atomic<const std::type_info*> key;
+        std::atomic<const uniform_type_info*> value;
+    };
+
+    static constexpr size_t tinfo_cache_size = 1024;
+
+    // open addressing cache mapping the addresses of std::type_info
+    // instances to uniform type informations; filled by by_type_info()
+    // and never erased, since uniform type informations are never removed
+    mutable tinfo_slot m_by_tinfo[tinfo_cache_size];
+
     // maps sizeof(-integer_type-) to { signed-names-set, unsigned-names-set }
     int_map_type m_ints;
 
+    // maps type signatures of known tuple types to factories
+    // creating statically typed tuples
+    signature_map_type m_signatures;
+
+    struct pending_signature {
+        std::vector<const std::type_info*> types;
+        tuple_factory factory;
+    };
+
+    // signatures containing at least one type that is not announced yet
+    std::vector<pending_signature> m_pending_signatures;
+
+    mutable util::shared_spinlock m_signatures_mtx;
+
+    // returns false if at least one type is not announced yet
+    bool to_signature(const std::type_info* const* types,
+                      size_t size,
+                      signature_type& storage) const;
+
+    // moves all pending signatures with announced types to m_signatures
+    void insert_pending_signatures();
+
     uniform_type_info_map();
 
     ~uniform_type_info_map();
@@ -83,6 +83,8 @@ class value_guard {
 
  public:
 
+    typedef typename tdata_from_type_list<FilteredPattern>::type data_type;
+
     value_guard() = default;
     value_guard(const value_guard&) = default;
 
@@ -95,9 +97,15 @@ class value_guard {
         return _eval(m_args.head, m_args.tail(), args...);
     }
 
+    // values this guard compares the arguments to;
+    // util::void_type marks an unguarded argument
+    inline const data_type& args() const {
+        return m_args;
+    }
+
  private:
 
-    typename tdata_from_type_list<FilteredPattern>::type m_args;
+    data_type m_args;
 
     template<typename T, typename U>
     static inline bool cmp(const T& lhs, const U& rhs) {
@@ -355,10 +355,12 @@ class local_actor : public actor {
     }
 
     inline void send_message(channel* whom, any_tuple&& what) {
+        flush_pending_forward();
         whom->enqueue(this, std::move(what));
     }
 
     inline void send_message(actor* whom, any_tuple&& what) {
+        flush_pending_forward();
         if (chaining_enabled()) {
             if (whom->chained_enqueue(this, std::move(what))) {
                 m_chained_actor = whom;
@@ -368,6 +370,7 @@ class local_actor : public actor {
     }
 
     inline message_id_t send_sync_message(actor* whom, any_tuple&& what) {
+        flush_pending_forward();
         auto id = ++m_last_request_id;
         CPPA_REQUIRE(id.is_request());
         if (chaining_enabled()) {
@@ -392,6 +395,17 @@ class local_actor : public actor {
 
     void forward_message(const actor_ptr& new_receiver);
 
+    // moves the message of @p node to the receiver of a pending
+    // forward_message() once the callback processing @p node returned
+    void flush_forward(detail::recursive_queue_node* node);
+
+    // sends the message of a pending forward_message() before any other
+    // message, i.e., forward_to() keeps the order of messages sent by
+    // this actor; the callback still uses the message, so it is shared
+    inline void flush_pending_forward() {
+        if (m_forward_node != nullptr) send_pending_forward();
+    }
+
     inline const actor_ptr& chained_actor() {
         return m_chained_actor;
     }
@@ -444,6 +458,13 @@ class local_actor : public actor {
     // points to m_dummy_node if no callback is currently invoked,
     // points to the node under processing otherwise
     detail::recursive_queue_node* m_current_node;
+    // node that was forwarded by the currently invoked callback;
+    // its message is moved to m_forward_receiver afterwards
+    detail::recursive_queue_node* m_forward_node;
+    // receiver of m_forward_node
+    actor_ptr m_forward_receiver;
+    // original ID of m_forward_node if it was a synchronous request
+    message_id_t m_forward_id;
     // {group => subscription} map of all joined groups
     std::map<group_ptr, group::subscription> m_subscriptions;
 
@@ -462,6 +483,9 @@ class local_actor : public actor {
 
  private:
 
+    // sends the message of m_forward_node as a shared copy
+    void send_pending_forward();
+
     detail::instance_wrapper* outer_memory;
 
 };
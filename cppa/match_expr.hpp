@@ -31,6 +31,13 @@
 #ifndef CPPA_MATCH_EXPR_HPP
 #define CPPA_MATCH_EXPR_HPP
 
+#include <vector>
+#include <limits>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+
+#include "cppa/atom.hpp"
 #include "cppa/option.hpp"
 #include "cppa/guard_expr.hpp"
 #include "cppa/partial_function.hpp"
@@ -47,6 +54,7 @@
 #include "cppa/detail/projection.hpp"
 #include "cppa/detail/value_guard.hpp"
 #include "cppa/detail/pseudo_tuple.hpp"
+#include "cppa/detail/tuple_signature.hpp"
 
 namespace cppa { namespace detail {
 
@@ -481,17 +489,121 @@ struct pjf_same_pattern
                        typename Second::second::pattern_type> {
 };
 
+// bitmask with one bit per case in Token, where Token is
+// a group of eval_order, i.e., type_list<type_pair<integral_constant<...>,
+//                                                   case>,
+//                                         ...>
+template<class Token>
+struct case_mask;
+
+template<>
+struct case_mask<util::empty_type_list> {
+    static constexpr std::uint64_t value = 0;
+};
+
+template<size_t P, typename T, typename... Ts>
+struct case_mask<util::type_list<util::type_pair<std::integral_constant<size_t,P>,
+                                                 T>,
+                                 Ts...>> {
+    static constexpr std::uint64_t value =
+            (static_cast<std::uint64_t>(1) << P)
+          | case_mask<util::type_list<Ts...>>::value;
+};
+
+// extracts the leading atom from the value guard of a case,
+// e.g., the guard of on(atom("foo"), arg_match) leads with atom("foo")
+template<class Guard>
+struct leading_atom_of {
+    static constexpr bool value = false;
+    static inline atom_value get(const Guard&) {
+        return static_cast<atom_value>(0);
+    }
+};
+
+template<typename... Ts>
+struct leading_atom_of<value_guard<util::type_list<atom_value, Ts...>>> {
+    static constexpr bool value = true;
+    typedef value_guard<util::type_list<atom_value, Ts...>> guard_type;
+    static inline atom_value get(const guard_type& guard) {
+        return guard.args().head;
+    }
+};
+
+template<class Case>
+struct has_leading_atom {
+    static constexpr bool value =
+            leading_atom_of<typename Case::second_type::guard_type>::value;
+};
+
+// bitmask of all cases with a leading atom
+template<class Cases, size_t Pos = 0>
+struct leading_atom_cases {
+    static constexpr std::uint64_t value = 0;
+    // collects {leading atom, case bit} pairs
+    template<class Data, class Container>
+    static inline void collect(const Data&, Container&) { }
+};
+
+template<class Case, class... Cases, size_t Pos>
+struct leading_atom_cases<util::type_list<Case, Cases...>, Pos> {
+    typedef leading_atom_of<typename Case::second_type::guard_type> trait;
+    typedef leading_atom_cases<util::type_list<Cases...>, Pos + 1> next;
+    static constexpr std::uint64_t value =
+            (trait::value ? (static_cast<std::uint64_t>(1) << Pos) : 0)
+          | next::value;
+    template<class Data, class Container>
+    static inline void collect(const Data& data, Container& storage) {
+        if (trait::value) {
+            storage.emplace_back(trait::get(get<Pos>(data).second.guard()),
+                                 static_cast<std::uint64_t>(1) << Pos);
+        }
+        next::collect(data, storage);
+    }
+};
+
+// returns the leading atom of the arguments of match_expr::operator()
+// or 0 if the first argument is not an atom
+template<typename T>
+inline atom_value leading_atom_value(const T&) {
+    return static_cast<atom_value>(0);
+}
+
+inline atom_value leading_atom_value(const atom_value& what) {
+    return what;
+}
+
+inline atom_value leading_atom_value(const std::reference_wrapper<atom_value>& what) {
+    return what.get();
+}
+
+inline atom_value leading_atom_value(const std::reference_wrapper<const atom_value>& what) {
+    return what.get();
+}
+
+inline atom_value leading_atom(const tdata<>&) {
+    return static_cast<atom_value>(0);
+}
+
+template<typename Head, typename... Tail>
+inline atom_value leading_atom(const tdata<Head, Tail...>& tup) {
+    return leading_atom_value(tup.head);
+}
+
 // last invocation step; evaluates a {projection, tpartial_function} pair
 template<typename Data>
 struct invoke_helper3 {
     const Data& data;
-    invoke_helper3(const Data& mdata) : data(mdata) { }
+    std::uint64_t bitfield;
+    invoke_helper3(const Data& mdata, std::uint64_t bits)
+    : data(mdata), bitfield(bits) { }
     template<size_t P, typename T, typename... Args>
     inline bool operator()(util::type_pair<std::integral_constant<size_t,P>,T>,
                            Args&&... args) const {
-        const auto& target = get<P>(data);
-        return target.first(target.second, std::forward<Args>(args)...);
-        //return (get<Pos>(data))(args...);
+        if (bitfield & (static_cast<std::uint64_t>(1) << P)) {
+            const auto& target = get<P>(data);
+            return target.first(target.second, std::forward<Args>(args)...);
+        }
+        return false;
     }
 };
 
@@ -500,7 +612,9 @@ struct invoke_helper2 {
     typedef Pattern pattern_type;
     typedef typename util::tl_filter_not_type<Pattern,anything>::type arg_types;
     const Data& data;
-    invoke_helper2(const Data& mdata) : data(mdata) { }
+    std::uint64_t bitfield;
+    invoke_helper2(const Data& mdata, std::uint64_t bits)
+    : data(mdata), bitfield(bits) { }
     template<typename... Args>
     bool invoke(Args&&... args) const {
         typedef invoke_policy<Pattern> impl;
@@ -511,7 +625,7 @@ struct invoke_helper2 {
     bool operator()(Args&&... args) const {
         //static_assert(false, "foo");
         Token token;
-        invoke_helper3<Data> fun{data};
+        invoke_helper3<Data> fun{data, bitfield};
         return util::static_foreach<0, Token::size>
                ::eval_or(token, fun, std::forward<Args>(args)...);
     }
@@ -533,32 +647,29 @@ struct invoke_helper {
     bool operator()(Token, Args&&... args) {
         typedef typename Token::head type_pair;
         typedef typename type_pair::second leaf_pair;
-        if (bitfield & 0x01) {
+        if (bitfield & case_mask<Token>::value) {
             // next invocation step
             invoke_helper2<Data,
                            Token,
-                           typename leaf_pair::pattern_type> fun{data};
+                           typename leaf_pair::pattern_type> fun{data, bitfield};
             return fun.invoke(std::forward<Args>(args)...);
         }
-        bitfield >>= 1;
-        //++enabled;
         return false;
     }
 };
 
+// enables all cases of each group that is able to invoke the given arguments
 struct can_invoke_helper {
     std::uint64_t& bitfield;
-    size_t i;
-    can_invoke_helper(std::uint64_t& mbitfield) : bitfield(mbitfield), i(0) { }
+    can_invoke_helper(std::uint64_t& mbitfield) : bitfield(mbitfield) { }
     template<class Token, typename... Args>
     void operator()(Token, Args&&... args) {
         typedef typename Token::head type_pair;
         typedef typename type_pair::second leaf_pair;
         typedef invoke_policy<typename leaf_pair::pattern_type> impl;
         if (impl::can_invoke(std::forward<Args>(args)...)) {
-            bitfield |= (0x01 << i);
+            bitfield |= case_mask<Token>::value;
         }
-        ++i;
     }
 };
 
@@ -638,7 +749,7 @@ class match_expr {
     }
 
     bool invoke(any_tuple&& tup) {
-        any_tuple tmp{tup};
+        any_tuple tmp{std::move(tup)};
         return _invoke(tmp);
     }
 
@@ -661,7 +772,7 @@ class match_expr {
     }
 
     bool operator()(any_tuple&& tup) {
-        any_tuple tmp{tup};
+        any_tuple tmp{std::move(tup)};
         return _invoke(tmp);
     }
 
@@ -673,7 +784,8 @@ class match_expr {
         // applies implicit conversions etc
         tuple_type tup{std::forward<Args>(args)...};
         auto& type_token = typeid(typename tuple_type::types);
-        auto enabled_begin = get_cache_entry(&type_token, tup);
+        auto enabled_begin = get_cache_entry(&type_token, tup,
+                                             detail::leading_atom(tup));
 
         typedef typename util::if_else_c<
                     has_manipulator,
@@ -743,68 +855,163 @@ class match_expr {
     //                   ...>
     detail::tdata<Cases...> m_cases;
 
-    static constexpr size_t cache_size = 10;
-    //typedef std::array<bool, eval_order::size> cache_entry;
-    //typedef typename cache_entry::iterator cache_entry_iterator;
-    //typedef std::pair<const std::type_info*, cache_entry> cache_element;
+    // the dispatch cache maps {type token, leading atom} pairs to a bitmask
+    // with one bit per case (a set bit marks a candidate); the leading atom
+    // is used only if a case of this match expression has a leading atom
+    // and is 0 otherwise; it's unambiguous, because a type token
+    // determines whether a tuple starts with an atom
 
-    // std::uint64_t is used as a bitmask to enable/disable groups
+    static constexpr bool has_atom_cases =
+            util::tl_exists<cases_list, detail::has_leading_atom>::value;
 
-    typedef std::pair<const std::type_info*, std::uint64_t> cache_element;
+    static constexpr size_t min_cache_size = 16;
 
-    util::fixed_vector<cache_element, cache_size> m_cache;
+    static constexpr size_t max_cache_size = 1024;
+
+    struct cache_element {
+        const std::type_info* type_token;
+        atom_value atom;
+        std::uint64_t bitfield;
+    };
 
-    // ring buffer like access to m_cache
-    size_t m_cache_begin;
-    size_t m_cache_end;
+    // open addressing hash table with linear probing, size is a power of 2
+    std::vector<cache_element> m_cache;
 
-    cache_element m_dummy;
+    // number of used entries in m_cache
+    size_t m_cache_fill;
 
-    static inline void advance_(size_t& i) {
-        i = (i + 1) % cache_size;
+    static inline size_t hash_of(const std::type_info* type_token,
+                                 atom_value atom) {
+        auto h = static_cast<std::uint64_t>(
+                     reinterpret_cast<std::uintptr_t>(type_token) >> 3);
+        h ^= static_cast<std::uint64_t>(atom) * 0x9E3779B97F4A7C15ULL;
+        return static_cast<size_t>(h ^ (h >> 32));
     }
 
-    inline size_t find_token_pos(const std::type_info* type_token) {
-        for (size_t i = m_cache_begin ; i != m_cache_end; advance_(i)) {
-            if (m_cache[i].first == type_token) return i;
+    inline cache_element* find_entry(const std::type_info* type_token,
+                                     atom_value atom) {
+        auto mask = m_cache.size() - 1;
+        for (auto i = hash_of(type_token, atom) & mask; ; i = (i + 1) & mask) {
+            auto& entry = m_cache[i];
+            if (entry.type_token == nullptr
+                    || (entry.type_token == type_token && entry.atom == atom)) {
+                return &entry;
+            }
         }
-        return m_cache_end;
+    }
+
+    void resize_cache(size_t new_size) {
+        cache_element empty{nullptr, static_cast<atom_value>(0), 0};
+        std::vector<cache_element> old_cache(new_size, empty);
+        old_cache.swap(m_cache);
+        for (auto& entry : old_cache) {
+            if (entry.type_token != nullptr) {
+                *find_entry(entry.type_token, entry.atom) = entry;
+            }
+        }
+    }
+
+    // maps leading atoms to cases, sorted by atom value;
+    // initialized lazily on first use
+    std::vector<std::pair<atom_value, std::uint64_t>> m_atom_table;
+
+    bool m_atom_table_ready;
+
+    // returns a bitmask with all cases that can handle a tuple with leading
+    // atom @p what (all cases without leading atom + matching atom cases)
+    std::uint64_t atom_mask(atom_value what) {
+        typedef detail::leading_atom_cases<cases_list> atom_cases;
+        if (!m_atom_table_ready) {
+            atom_cases::collect(m_cases, m_atom_table);
+            std::sort(m_atom_table.begin(), m_atom_table.end());
+            // merge cases with the same atom
+            auto i = m_atom_table.begin();
+            for (auto j = i; j != m_atom_table.end(); ++j) {
+                if (i->first != j->first) *(++i) = *j;
+                else if (i != j) i->second |= j->second;
+            }
+            if (!m_atom_table.empty()) {
+                m_atom_table.erase(i + 1, m_atom_table.end());
+            }
+            m_atom_table_ready = true;
+        }
+        auto result = ~atom_cases::value;
+        auto pred = [](const std::pair<atom_value, std::uint64_t>& lhs,
+                       atom_value rhs) {
+            return lhs.first < rhs;
+        };
+        auto i = std::lower_bound(m_atom_table.begin(), m_atom_table.end(),
+                                  what, pred);
+        if (i != m_atom_table.end() && i->first == what) result |= i->second;
+        return result;
+    }
+
+    static inline atom_value leading_atom(const detail::abstract_tuple& value) {
+        if (has_atom_cases && value.size() > 0) {
+            static const uniform_type_info* atom_type =
+                    uniform_typeid<atom_value>();
+            if (value.type_at(0) == atom_type) {
+                return *reinterpret_cast<const atom_value*>(value.at(0));
+            }
+        }
+        return static_cast<atom_value>(0);
     }
 
     template<class Tuple>
     std::uint64_t get_cache_entry(const std::type_info* type_token,
-                                  const Tuple& value) {
+                                  const Tuple& value,
+                                  atom_value atom) {
         CPPA_REQUIRE(type_token != nullptr);
         if (value.impl_type() == detail::dynamically_typed) {
-            return m_dummy.second; // all groups enabled
+            // dynamically typed tuples are not cached, but we
+            // still can select the candidates by the leading atom
+            return has_atom_cases ? atom_mask(atom)
+                                  : std::numeric_limits<std::uint64_t>::max();
         }
-        size_t i = find_token_pos(type_token);
+        if (m_cache.empty()) resize_cache(min_cache_size);
+        auto entry = find_entry(type_token, atom);
         // if we didn't found a cache entry ...
-        if (i == m_cache_end) {
-            // ... 'create' one (override oldest element in cache if full)
-            advance_(m_cache_end);
-            if (m_cache_end == m_cache_begin) advance_(m_cache_begin);
-            m_cache[i].first = type_token;
-            m_cache[i].second = 0;
+        if (entry->type_token == nullptr) {
+            // ... create one (keep load factor <= 0.5; start
+            // from scratch if the cache would exceed max_cache_size)
+            if ((m_cache_fill + 1) * 2 > m_cache.size()) {
+                if (m_cache.size() < max_cache_size) {
+                    resize_cache(m_cache.size() * 2);
+                }
+                else {
+                    m_cache.clear();
+                    m_cache_fill = 0;
+                    resize_cache(min_cache_size);
+                }
+                entry = find_entry(type_token, atom);
+            }
+            ++m_cache_fill;
+            entry->type_token = type_token;
+            entry->atom = atom;
+            entry->bitfield = 0;
             eval_order token;
-            detail::can_invoke_helper fun{m_cache[i].second};
+            detail::can_invoke_helper fun{entry->bitfield};
             util::static_foreach<0, eval_order::size>
             ::_(token, fun, *type_token, value);
+            if (has_atom_cases) entry->bitfield &= atom_mask(atom);
         }
-        return m_cache[i].second;
+        return entry->bitfield;
     }
 
     void init() {
-        m_dummy.second = std::numeric_limits<std::uint64_t>::max();
-        m_cache.resize(cache_size);
-        for (auto& entry : m_cache) { entry.first = nullptr; }
-        m_cache_begin = m_cache_end = 0;
+        m_cache_fill = 0;
+        m_atom_table_ready = false;
+        // enables the deserializer to create statically typed tuples
+        // for incoming messages matching one of our patterns
+        static bool signatures_registered =
+                detail::register_tuple_signatures<cases_list>::_();
+        static_cast<void>(signatures_registered);
     }
 
     template<typename AbstractTuple, typename NativeDataPtr>
     bool _do_invoke(AbstractTuple& vals, NativeDataPtr ndp) {
         const std::type_info* type_token = vals.type_token();
-        auto bitfield = get_cache_entry(type_token, vals);
+        auto bitfield = get_cache_entry(type_token, vals, leading_atom(vals));
         eval_order token;
         detail::invoke_helper<decltype(m_cases)> fun{m_cases, bitfield};
         return util::static_foreach<0, eval_order::size>
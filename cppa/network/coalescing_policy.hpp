@@ -0,0 +1,74 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011, 2012                                                   *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation, either version 3 of the License                  *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+#ifndef CPPA_COALESCING_POLICY_HPP
+#define CPPA_COALESCING_POLICY_HPP
+
+#include <chrono>
+#include <cstddef>
+
+namespace cppa { namespace network {
+
+/**
+ * @brief Configures how many outgoing messages a peer collects before
+ *        writing them to its socket. A peer writes its buffer as soon
+ *        as one of the three limits is reached.
+ *
+ * The default policy writes each message immediately.
+ */
+struct coalescing_policy {
+
+    /**
+     * @brief Maximum number of buffered bytes.
+     */
+    size_t max_bytes;
+
+    /**
+     * @brief Maximum number of buffered messages.
+     */
+    size_t max_messages;
+
+    /**
+     * @brief Maximum time a message remains in the buffer.
+     * @note The middleman rounds this value up to full milliseconds.
+     */
+    std::chrono::microseconds max_delay;
+
+    inline coalescing_policy(size_t bytes = 0,
+                             size_t messages = 1,
+                             std::chrono::microseconds delay
+                                 = std::chrono::microseconds(0))
+    : max_bytes(bytes), max_messages(messages), max_delay(delay) { }
+
+};
+
+} } // namespace cppa::network
+
+#endif // CPPA_COALESCING_POLICY_HPP
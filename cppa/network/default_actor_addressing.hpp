@@ -31,8 +31,10 @@
 #ifndef CPPA_DEFAULT_ACTOR_ADDRESSING_HPP
 #define CPPA_DEFAULT_ACTOR_ADDRESSING_HPP
 
-#include <map>
+#include <vector>
 #include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "cppa/actor_proxy.hpp"
 #include "cppa/actor_addressing.hpp"
@@ -46,9 +48,14 @@ class default_actor_addressing : public actor_addressing {
 
  public:
 
-    default_actor_addressing(default_protocol* parent = nullptr);
+    /**
+     * @brief A small integer that identifies a known node. Nodes are
+     *        interned once, i.e., looking up a proxy never needs
+     *        to compare full {@link process_information} objects.
+     */
+    typedef std::uint32_t node_handle;
 
-    typedef std::map<actor_id,weak_actor_proxy_ptr> proxy_map;
+    default_actor_addressing(default_protocol* parent = nullptr);
 
     atom_value technology_id() const;
 
@@ -67,17 +74,75 @@ class default_actor_addressing : public actor_addressing {
              actor_id aid,
              const actor_proxy_ptr& proxy);
 
-    proxy_map& proxies(process_information& from);
+    // returns all proxy instances for given parent that are still alive
+    std::vector<actor_proxy_ptr> proxies(const process_information& from);
+
+    void erase(const process_information& info);
 
-    void erase(process_information& info);
+    void erase(const process_information& info, actor_id aid);
 
-    void erase(process_information& info, actor_id aid);
+    /**
+     * @brief Sends a KILL_PROXY message to all proxies of @p info
+     *        and erases all proxies of @p info in a single pass.
+     */
+    void kill_proxies(const process_information& info, std::uint32_t reason);
+
+    // sends all pending MONITOR requests for given node as a single message
+    void flush_monitors(const process_information& info);
 
  private:
 
+    struct node_hash {
+        size_t operator()(const process_information& node) const;
+    };
+
+    struct node_entry {
+        process_information_ptr info;
+        // IDs of all proxies of this node stored in m_proxies, i.e.,
+        // node-level operations never need to scan the whole table
+        std::unordered_set<actor_id> aids;
+        // IDs of newly created proxies that were not yet monitored
+        std::vector<actor_id> pending_monitors;
+    };
+
+    typedef std::unordered_map<process_information,node_handle,node_hash>
+            handle_map;
+
+    // proxies are stored by (node handle, actor id) in a single table
+    typedef std::unordered_map<std::uint64_t,weak_actor_proxy_ptr> proxy_map;
+
+    static constexpr node_handle invalid_handle = 0xFFFFFFFF;
+
+    static inline std::uint64_t key_of(node_handle handle, actor_id aid) {
+        return (static_cast<std::uint64_t>(handle) << 32) | aid;
+    }
+
+    // returns the handle for node or invalid_handle
+    node_handle handle_of(const process_information& node) const;
+
+    // returns the handle for node, assigning a new handle if needed
+    node_handle intern(const process_information& node);
+
+    actor_proxy_ptr get(node_handle handle, actor_id aid);
+
+    void put(node_handle handle, actor_id aid, const actor_proxy_ptr& proxy);
+
+    actor_ptr get_or_put(node_handle handle, actor_id aid);
+
+    // removes node from m_handles and recycles its handle
+    void release(handle_map::iterator i);
+
     default_protocol* m_parent;
     process_information_ptr m_pinf;
-    std::map<process_information,proxy_map> m_proxies;
+
+    // cached copies of m_pinf's fields used on each (de)serialization
+    std::uint32_t m_pid;
+    process_information::node_id_type m_nid;
+
+    handle_map m_handles;
+    std::vector<node_entry> m_nodes;
+    std::vector<node_handle> m_free_handles;
+    proxy_map m_proxies;
 
 };
 
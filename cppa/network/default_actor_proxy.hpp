@@ -33,6 +33,7 @@
 
 #include "cppa/actor_proxy.hpp"
 
+#include "cppa/network/message_header.hpp"
 #include "cppa/network/default_protocol.hpp"
 
 #include "cppa/detail/abstract_actor.hpp"
@@ -65,6 +66,8 @@ class default_actor_proxy : public detail::abstract_actor<actor_proxy> {
 
     void local_unlink_from(const actor_ptr& other);
 
+    void link_exited(actor* sender, const any_tuple& exit_msg);
+
     inline const process_information_ptr& process_info() const {
         return m_pinf;
     }
@@ -77,7 +80,14 @@ class default_actor_proxy : public detail::abstract_actor<actor_proxy> {
 
     void forward_msg(const actor_ptr& sender,
                      any_tuple msg,
-                     message_id_t mid = message_id_t());
+                     message_id_t mid = message_id_t(),
+                     message_header::frame_type type = message_header::user_frame);
+
+    // LINK and UNLINK messages are addressed to the network layer
+    inline void forward_control_msg(any_tuple msg) {
+        forward_msg(this, std::move(msg), message_id_t(),
+                    message_header::control_frame);
+    }
 
     default_protocol_ptr    m_proto;
     process_information_ptr m_pinf;
@@ -32,6 +32,7 @@
 #define CPPA_DEFAULT_PEER_IMPL_HPP
 
 #include <map>
+#include <vector>
 #include <cstdint>
 
 #include "cppa/actor_proxy.hpp"
@@ -45,6 +46,7 @@
 #include "cppa/network/output_stream.hpp"
 #include "cppa/network/continuable_reader.hpp"
 #include "cppa/network/continuable_io.hpp"
+#include "cppa/network/message_header.hpp"
 #include "cppa/network/default_message_queue.hpp"
 
 namespace cppa { namespace network {
@@ -82,10 +84,31 @@ class default_peer : public continuable_io {
         return *m_node;
     }
 
+    /**
+     * @brief Sends <tt>{'EXIT', reason}</tt> from @p sender to the actor
+     *        @p aid of this node. All exit messages of a sender that are
+     *        already queued in the middleman are sent as a single message.
+     * @note @p sender must not send any message afterwards, i.e.,
+     *       it has finished execution.
+     */
+    void exit_later(const actor_ptr& sender, actor_id aid, std::uint32_t reason);
+
     inline bool has_unwritten_data() const {
         return m_has_unwritten_data;
     }
 
+    // returns true if this peer holds messages back because of
+    // its coalescing policy
+    inline bool has_buffered_data() const {
+        return !m_has_unwritten_data && !m_wr_buf.empty();
+    }
+
+    /**
+     * @brief Writes all buffered messages regardless of
+     *        the coalescing policy.
+     */
+    void flush();
+
  protected:
 
     ~default_peer();
@@ -110,6 +133,15 @@ class default_peer : public continuable_io {
     process_information_ptr m_node;
     bool m_has_unwritten_data;
 
+    // number of messages in m_wr_buf that were not yet flushed
+    size_t m_unflushed_messages;
+
+    // true if a delayed flush is pending in the middleman
+    bool m_flush_scheduled;
+
+    // incremented on each flush; makes pending delayed flushes obsolete
+    size_t m_flush_epoch;
+
     const uniform_type_info* m_meta_hdr;
     const uniform_type_info* m_meta_msg;
 
@@ -132,18 +164,47 @@ class default_peer : public continuable_io {
 
     partial_function m_content_handler;
 
+    // KILL_PROXY notifications that are sent as a single message
+    // once the middleman is done with its current task
+    std::vector<actor_id> m_pending_kills;
+    std::vector<std::uint32_t> m_pending_kill_reasons;
+
     void monitor(const actor_ptr& sender, const process_information_ptr& node, actor_id aid);
 
     void kill_proxy(const actor_ptr& sender, const process_information_ptr& node, actor_id aid, std::uint32_t reason);
 
+    void kill_proxy_later(actor_id aid, std::uint32_t reason);
+
+    void flush_kill_proxies();
+
+    // exit messages of one sender that are sent as a single message
+    // once the middleman is done with its current task
+    struct pending_exit {
+        actor_ptr sender;
+        std::uint32_t reason;
+        std::vector<actor_id> receivers;
+    };
+
+    std::vector<pending_exit> m_pending_exits;
+
+    void flush_exits();
+
     void link(const actor_ptr& sender, const actor_ptr& ptr);
 
+    // decodes a control message and dispatches it to
+    // monitor, kill_proxy, link or unlink
+    void read_control_msg(const message_header& hdr, deserializer* source);
+
+    // writes the compact representation of a control message
+    void write_control_msg(serializer* sink, const any_tuple& msg);
+
     void unlink(const actor_ptr& sender, const actor_ptr& ptr);
 
     void deliver(const message_header& hdr, any_tuple msg);
 
-    inline void enqueue(const any_tuple& msg) {
-        enqueue({nullptr, nullptr}, msg);
+    inline void enqueue_control(const any_tuple& msg) {
+        enqueue({nullptr, nullptr, message_id_t::invalid,
+                 message_header::control_frame}, msg);
     }
 
     /*
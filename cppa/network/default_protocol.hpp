@@ -39,6 +39,7 @@
 
 #include "cppa/network/protocol.hpp"
 #include "cppa/network/default_peer.hpp"
+#include "cppa/network/coalescing_policy.hpp"
 #include "cppa/network/default_peer_acceptor.hpp"
 #include "cppa/network/default_message_queue.hpp"
 #include "cppa/network/default_actor_addressing.hpp"
@@ -51,6 +52,15 @@ class default_protocol : public protocol {
 
  public:
 
+    /**
+     * @brief Identifies the wire format of this protocol. Both sides send
+     *        it first on a new connection and close the connection if the
+     *        versions differ. The value never matches an actor or process
+     *        ID, i.e., nodes using the previous (unversioned) format are
+     *        rejected as well.
+     */
+    static constexpr std::uint32_t wire_format_version = 0xCA000001;
+
     default_protocol(abstract_middleman* parent);
 
     atom_value identifier() const;
@@ -83,6 +93,28 @@ class default_protocol : public protocol {
 
     void continue_writer(const default_peer_ptr& pptr);
 
+    // note: not thread-safe; call only in run_later functor!
+    void run_delayed(std::chrono::microseconds delay, std::function<void()> fun);
+
+    /**
+     * @brief Sets the coalescing policy for all peers.
+     * @note Thread-safe; takes effect for all messages written afterwards.
+     */
+    void set_coalescing_policy(const coalescing_policy& policy);
+
+    // note: not thread-safe; call only in run_later functor!
+    inline const coalescing_policy& coalescing() const {
+        return m_coalescing;
+    }
+
+    /**
+     * @brief Causes the peer connected to the node of @p whom to
+     *        write all buffered messages, including all messages
+     *        previously sent to @p whom.
+     * @note Thread-safe; has no effect if @p whom is not a remote actor.
+     */
+    void flush(const actor_ptr& whom);
+
     // covariant return type
     default_actor_addressing* addressing();
 
@@ -94,6 +126,7 @@ class default_protocol : public protocol {
     };
 
     default_actor_addressing m_addressing;
+    coalescing_policy m_coalescing;
     std::map<actor_ptr,std::vector<default_peer_acceptor_ptr> > m_acceptors;
     std::map<process_information,peer_entry> m_peers;
 
@@ -31,7 +31,10 @@
 #ifndef CPPA_MESSAGE_HEADER_HPP
 #define CPPA_MESSAGE_HEADER_HPP
 
+#include <cstdint>
+
 #include "cppa/actor.hpp"
+#include "cppa/any_tuple.hpp"
 #include "cppa/message_id.hpp"
 
 namespace cppa { namespace network {
@@ -44,28 +47,73 @@ class message_header {
 
  public:
 
+    /**
+     * @brief Distinguishes messages between actors from messages
+     *        of the network layer itself, e.g., MONITOR or KILL_PROXY.
+     */
+    enum frame_type : std::uint8_t {
+        /**
+         * @brief An ordinary message that is delivered to its receiver.
+         */
+        user_frame,
+        /**
+         * @brief A message that is processed by the network layer.
+         */
+        control_frame
+    };
+
+    /**
+     * @brief Identifies the content of a control frame. Control messages
+     *        store their opcode as first element, i.e., the network
+     *        layer never needs to compare atoms to encode them.
+     */
+    enum control_opcode : std::uint8_t {
+        // monitor messages are sent automatically whenever
+        // default_actor_addressing creates new proxies
+        monitor_op = 1,
+        kill_proxy_op,
+        link_op,
+        unlink_op,
+        // exit messages of one actor to any number of actors on the peer
+        exit_op
+    };
+
     actor_ptr    sender;
     actor_ptr    receiver;
     message_id_t id;
+    frame_type   type;
 
     message_header();
 
     message_header(const actor_ptr& sender,
                    const actor_ptr& receiver,
-                   message_id_t id = message_id_t::invalid);
+                   message_id_t id = message_id_t::invalid,
+                   frame_type type = user_frame);
 
 };
 
 inline bool operator==(const message_header& lhs, const message_header& rhs) {
     return    lhs.sender == rhs.sender
            && lhs.receiver == rhs.receiver
-           && lhs.id == rhs.id;
+           && lhs.id == rhs.id
+           && lhs.type == rhs.type;
 }
 
 inline bool operator!=(const message_header& lhs, const message_header& rhs) {
     return !(lhs == rhs);
 }
 
+/**
+ * @brief Creates the content of a control frame, i.e.,
+ *        <tt>{op, args...}</tt>.
+ */
+template<typename... Ts>
+inline any_tuple make_control_msg(message_header::control_opcode op,
+                                  Ts&&... args) {
+    return make_any_tuple(static_cast<std::uint8_t>(op),
+                          std::forward<Ts>(args)...);
+}
+
 } } // namespace cppa::network
 
 #endif // CPPA_MESSAGE_HEADER_HPP
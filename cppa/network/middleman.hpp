@@ -32,6 +32,7 @@
 #define MIDDLEMAN_HPP
 
 #include <map>
+#include <chrono>
 #include <vector>
 #include <memory>
 #include <functional>
@@ -97,13 +98,27 @@ class abstract_middleman : public middleman {
     void stop_reader(const continuable_reader_ptr& what);
     void continue_reader(const continuable_reader_ptr& what);
 
+    // note: not thread-safe; call only from within the event loop
+    void run_delayed(std::chrono::microseconds delay, std::function<void()> fun);
+
  protected:
 
+    typedef std::chrono::steady_clock::time_point time_point;
+
     inline void quit() { m_done = true; }
     inline bool done() const { return m_done; }
 
+    // returns the timeout for the next poll in milliseconds
+    // or -1 if no delayed function is pending
+    int poll_timeout() const;
+
+    // runs all delayed functions that are due, or all
+    // delayed functions if @p run_all is true
+    void handle_timeouts(bool run_all = false);
+
     bool m_done;
     std::vector<continuable_reader_ptr> m_readers;
+    std::multimap<time_point,std::function<void()>> m_timeouts;
 
     middleman_event_handler& handler();
 
@@ -31,6 +31,7 @@
 #ifndef CPPA_PROTOCOL_HPP
 #define CPPA_PROTOCOL_HPP
 
+#include <chrono>
 #include <memory>
 #include <functional>
 #include <initializer_list>
@@ -105,6 +106,9 @@ class protocol : public ref_counted {
     // note: not thread-safe; call only in run_later functor!
     void stop_writer(continuable_reader* what);
 
+    // note: not thread-safe; call only in run_later functor!
+    void run_delayed(std::chrono::microseconds delay, std::function<void()> fun);
+
     inline abstract_middleman* parent() { return m_parent.get(); }
 
     inline const abstract_middleman* parent() const { return m_parent.get(); }
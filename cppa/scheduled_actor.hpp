@@ -46,7 +46,8 @@ enum class resume_result {
 
 enum scheduled_actor_type {
     context_switching_impl,
-    event_based_impl
+    event_based_impl,
+    coroutine_impl
 };
 
 /**
@@ -74,10 +75,25 @@ class scheduled_actor : public local_actor {
 
     inline bool is_hidden() const { return m_hidden; }
 
+    /**
+     * @brief Returns the index of the NUMA node this actor
+     *        prefers to run on or @p -1 if it can run on any node.
+     */
+    inline int node_affinity() const { return m_node_affinity; }
+
+    /**
+     * @brief Sets the index of the NUMA node this actor
+     *        prefers to run on, whereas @p -1 means any node.
+     * @note Nodes are numbered by the scheduler in ascending
+     *       order of their IDs, skipping nodes without CPUs.
+     */
+    inline void node_affinity(int node) { m_node_affinity = node; }
+
  protected:
 
     scheduler* m_scheduler;
     bool m_hidden;
+    int m_node_affinity;
 
     bool initialized();
 
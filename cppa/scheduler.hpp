@@ -33,6 +33,7 @@
 
 #include <chrono>
 #include <memory>
+#include <vector>
 #include <cstdint>
 #include <functional>
 
@@ -184,6 +185,13 @@ class scheduler {
                             init_callback init_cb,
                             scheduling_hint hint = scheduled) = 0;
 
+    /**
+     * @brief Spawns all event-based actors in @p what at once.
+     * @returns The spawned actors in the same order as in @p what.
+     */
+    virtual std::vector<actor_ptr> spawn_batch(const std::vector<scheduled_actor*>& what,
+                                               scheduling_hint hint = scheduled);
+
     // hide implementation details for documentation
 #   ifndef CPPA_DOCUMENTATION
 
@@ -240,6 +248,18 @@ void set_scheduler(scheduler* sched);
  */
 void set_default_scheduler(size_t num_threads);
 
+/**
+ * @brief Sets a thread pool scheduler with @p num_threads worker threads
+ *        that runs actors spawned with the {@link blocking_io} hint
+ *        in at most @p max_io_threads threads.
+ * @param min_io_threads Number of idle threads for {@link blocking_io}
+ *                       actors that are kept alive.
+ * @throws std::runtime_error if there's already a scheduler defined.
+ */
+void set_default_scheduler(size_t num_threads,
+                           size_t max_io_threads,
+                           size_t min_io_threads = 0);
+
 /**
  * @brief Returns the currently running scheduler.
  */
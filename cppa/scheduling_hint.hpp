@@ -59,7 +59,26 @@ enum scheduling_hint {
      * @brief Indicates that an actor takes part in cooperative scheduling,
      *        but it is ignored by {@link await_others_done()}.
      */
-    scheduled_and_hidden
+    scheduled_and_hidden,
+
+    /**
+     * @brief Indicates that an actor performs blocking I/O and should
+     *        run in its own thread, which is taken from a pool of
+     *        threads that is separated from the cooperatively
+     *        scheduled actors.
+     *
+     * Each running actor occupies one thread of the pool for its entire
+     * lifetime, just like a {@link detached} actor. The pool re-uses the
+     * threads of terminated actors and runs at most 64 threads by default
+     * (see {@link set_default_scheduler()}). An actor spawned while all
+     * threads are busy waits until one of the running actors is done,
+     * i.e., actors spawned with this hint should not wait for each other.
+     * Idle threads beyond the configured minimum are released after ten
+     * seconds. Destroying the scheduler waits for all of these actors.
+     * @note Event-based actors ignore this hint and are scheduled
+     *       cooperatively, since they cannot block by design.
+     */
+    blocking_io
 
 };
 
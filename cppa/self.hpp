@@ -98,6 +98,12 @@ class self_type : public convertible<self_type, actor*>,
         adopt_impl(ptr);
     }
 
+    // @brief Replaces the current value by @p ptr without touching
+    //        reference counts and returns the previous value.
+    inline pointer swap(pointer ptr) const {
+        return swap_impl(ptr);
+    }
+
     static void cleanup_fun(pointer);
 
  private:
@@ -114,6 +120,8 @@ class self_type : public convertible<self_type, actor*>,
 
     static void adopt_impl(pointer);
 
+    static pointer swap_impl(pointer);
+
 };
 
 /*
@@ -129,15 +137,12 @@ class scoped_self_setter {
 
  public:
 
-    inline scoped_self_setter(local_actor* new_value) {
-        m_original_value = self.release();
-        self.adopt(new_value);
-    }
+    inline scoped_self_setter(local_actor* new_value)
+    : m_original_value(self.swap(new_value)) { }
 
     inline ~scoped_self_setter() {
         // restore self
-        static_cast<void>(self.release());
-        self.adopt(m_original_value);
+        static_cast<void>(self.swap(m_original_value));
     }
 
  private:
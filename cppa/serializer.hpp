@@ -34,6 +34,7 @@
 #include <string>
 #include <cstddef> // size_t
 
+#include "cppa/primitive_type.hpp"
 #include "cppa/uniform_type_info.hpp"
 #include "cppa/detail/to_uniform_name.hpp"
 
@@ -99,6 +100,32 @@ class serializer {
      */
     virtual void write_tuple(size_t num, const primitive_variant* values) = 0;
 
+    /**
+     * @brief Writes @p num values of type @p ptype that are stored
+     *        contiguously at @p values, e.g., the content of a vector.
+     * @param ptype Type of each element in @p values.
+     * @param num Number of elements in @p values.
+     * @param values An array of size @p num.
+     * @note The default implementation calls {@link write_value()}
+     *       for each element.
+     */
+    virtual void write_raw_array(primitive_type ptype,
+                                 size_t num,
+                                 const void* values);
+
+    /**
+     * @brief Writes @p num values, where <tt>values[i]</tt> points to a
+     *        value of type <tt>ptypes[i]</tt>, e.g., the members of an object.
+     * @param num Size of the arrays @p ptypes and @p values.
+     * @param ptypes Type of each element in @p values.
+     * @param values Pointers to the values.
+     * @note The default implementation calls {@link write_value()}
+     *       for each element.
+     */
+    virtual void write_members(size_t num,
+                               const primitive_type* ptypes,
+                               const void* const* values);
+
     inline actor_addressing* addressing() { return m_addressing; }
 
  private:
@@ -64,6 +64,8 @@ class tpartial_function {
 
     typedef Result result_type;
 
+    typedef Guard guard_type;
+
     template<typename Fun, typename... G>
     tpartial_function(Fun&& fun, G&&... guard_args)
         : m_guard(std::forward<G>(guard_args)...)
@@ -87,6 +89,10 @@ class tpartial_function {
                ::_(m_expr, args...);
     }
 
+    inline const Guard& guard() const {
+        return m_guard;
+    }
+
  private:
 
     Guard m_guard;
@@ -0,0 +1,408 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011, 2012                                                   *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation, either version 3 of the License                  *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+
+#ifndef CPPA_TYPED_ACTOR_HPP
+#define CPPA_TYPED_ACTOR_HPP
+
+#include <array>
+#include <tuple>
+#include <utility>
+#include <typeinfo>
+#include <type_traits>
+
+#include "cppa/cppa.hpp"
+#include "cppa/behavior.hpp"
+#include "cppa/any_tuple.hpp"
+#include "cppa/event_based_actor.hpp"
+
+#include "cppa/util/rm_ref.hpp"
+#include "cppa/util/type_list.hpp"
+#include "cppa/util/apply_tuple.hpp"
+#include "cppa/util/callable_trait.hpp"
+#include "cppa/util/is_manipulator.hpp"
+
+#include "cppa/detail/types_array.hpp"
+#include "cppa/detail/pseudo_tuple.hpp"
+#include "cppa/detail/behavior_impl.hpp"
+#include "cppa/detail/abstract_tuple.hpp"
+#include "cppa/detail/tuple_signature.hpp"
+#include "cppa/detail/implicit_conversions.hpp"
+
+namespace cppa {
+
+/**
+ * @brief A handle to an actor that accepts only messages matching one
+ *        of its @p Signatures, e.g., <tt>int (int, int)</tt> denotes a
+ *        message consisting of two integers that is answered by an integer.
+ *
+ * Sending a message via a typed handle is checked at compile time.
+ * The actor itself dispatches on the type token of a message only, i.e.,
+ * without evaluating any pattern or guard.
+ * @note Only the result of a handler is guaranteed to match the result
+ *       type of its signature. Nothing prevents a handler from calling
+ *       {@link reply()} with values of any type, i.e., handlers should
+ *       return their result rather than replying explicitly.
+ * @see spawn_typed()
+ */
+template<typename... Signatures>
+class typed_actor {
+
+ public:
+
+    typedef util::type_list<Signatures...> signatures;
+
+    typed_actor() = default;
+
+    explicit typed_actor(actor_ptr ptr) : m_ptr(std::move(ptr)) { }
+
+    /**
+     * @brief Returns the untyped handle of this actor.
+     */
+    inline const actor_ptr& address() const { return m_ptr; }
+
+    inline explicit operator bool() const { return m_ptr != nullptr; }
+
+ private:
+
+    actor_ptr m_ptr;
+
+};
+
+namespace detail {
+
+template<typename Signature>
+struct typed_signature;
+
+template<typename Result, typename... Ts>
+struct typed_signature<Result (Ts...)> {
+    typedef Result result_type;
+    typedef util::type_list<Ts...> arg_types;
+};
+
+template<typename Result, class ArgTypes>
+struct typed_signature_from;
+
+template<typename Result, typename... Ts>
+struct typed_signature_from<Result, util::type_list<Ts...>> {
+    typedef Result type(typename util::rm_ref<Ts>::type...);
+};
+
+// the signature of the handler F, e.g., int (int, int) for
+// the handler [](int a, const int& b) { return a + b; }
+template<typename F>
+struct typed_signature_of {
+    typedef util::get_callable_trait<F> trait;
+    typedef typename typed_signature_from<typename trait::result_type,
+                                          typename trait::arg_types>::type
+            type;
+};
+
+// value == true if one of Signatures accepts a message of type Args
+template<class Args, typename... Signatures>
+struct typed_accepts : std::false_type { };
+
+template<class Args, typename Signature, typename... Signatures>
+struct typed_accepts<Args, Signature, Signatures...>
+        : std::integral_constant<bool,
+                 std::is_same<
+                     Args,
+                     typename typed_signature<Signature>::arg_types
+                 >::value
+              || typed_accepts<Args, Signatures...>::value> { };
+
+template<typename Result>
+struct typed_reply {
+    typedef typename strip_and_convert<Result>::type type;
+    template<class Apply, typename F, class Tuple>
+    static inline void _(F& fun, Tuple& args) {
+        self->reply_message(make_any_tuple(Apply::apply(fun, args)));
+    }
+};
+
+template<>
+struct typed_reply<void> {
+    typedef void type;
+    template<class Apply, typename F, class Tuple>
+    static inline void _(F& fun, Tuple& args) {
+        Apply::apply(fun, args);
+    }
+};
+
+template<typename F,
+         class ArgTypes = typename util::get_callable_trait<F>::arg_types>
+struct typed_case;
+
+// matches and invokes a single handler of a typed actor
+template<typename F, typename... Args>
+struct typed_case<F, util::type_list<Args...>> {
+
+    typedef util::type_list<typename util::rm_ref<Args>::type...> arg_types;
+
+    typedef typename util::get_callable_trait<F>::result_type result_type;
+
+    static constexpr bool is_manipulator = util::is_manipulator<F>::value;
+
+    static constexpr size_t size = sizeof...(Args);
+
+    // the reply of a handler is its result as stored by make_any_tuple,
+    // i.e., result_type is the reply type of the signature only if
+    // it is not converted implicitly (e.g., const char* to std::string)
+    static_assert(std::is_same<
+                      result_type,
+                      typename typed_reply<result_type>::type
+                  >::value,
+                  "the result of a typed handler must match its reply type");
+
+    static inline void register_signature() {
+        register_tuple_signature_of<arg_types>::_();
+    }
+
+    static bool matches(const any_tuple& tup) {
+        if (tup.impl_type() == statically_typed) {
+            return *tup.type_token() == typeid(arg_types);
+        }
+        // dynamically typed tuples, e.g., messages with a signature
+        // that was not announced before they were deserialized
+        if (tup.size() != size) return false;
+        auto& arr = static_types_array<
+                        typename util::rm_ref<Args>::type...>::arr;
+        for (size_t i = 0; i < size; ++i) {
+            if (tup.type_at(i) != arr[i]) return false;
+        }
+        return true;
+    }
+
+    template<class Tuple>
+    static void invoke(F& fun, Tuple& tup) {
+        typedef pseudo_tuple<typename util::rm_ref<Args>::type...> ttup_type;
+        ttup_type ttup;
+        for (size_t i = 0; i < size; ++i) {
+            ttup[i] = const_cast<void*>(tup.at(i));
+        }
+        typedef typename std::conditional<
+                    std::is_const<Tuple>::value,
+                    const ttup_type,
+                    ttup_type
+                >::type
+                args_type;
+        typedef util::apply_tuple_util<result_type,
+                                       is_manipulator,
+                                       (size > 0) ? 0 : 1,
+                                       (size > 0) ? size - 1 : 0>
+                apply;
+        args_type& args = ttup;
+        typed_reply<result_type>::template _<apply>(fun, args);
+    }
+
+    static inline void invoke(F& fun, any_tuple& tup) {
+        invoke(fun, tup, std::integral_constant<bool, is_manipulator>{});
+    }
+
+    static inline void invoke(F& fun, any_tuple& tup, std::true_type) {
+        tup.force_detach();
+        invoke(fun, *(tup.vals()));
+    }
+
+    static inline void invoke(F& fun, any_tuple& tup, std::false_type) {
+        invoke(fun, *(tup.cvals()));
+    }
+
+};
+
+// fills the handler table of a typed behavior and maps
+// a message to the index of its handler in this table
+template<size_t Pos, size_t Size>
+struct typed_dispatch {
+    template<class Funs>
+    static void invoke_at(Funs& funs, any_tuple& tup) {
+        typedef typename std::tuple_element<Pos, Funs>::type fun_type;
+        typed_case<fun_type>::invoke(std::get<Pos>(funs), tup);
+    }
+    template<class Funs, class Table>
+    static inline void fill(Table& table) {
+        table[Pos] = &invoke_at<Funs>;
+        typed_dispatch<Pos + 1, Size>::template fill<Funs>(table);
+    }
+    template<class Funs>
+    static inline size_t index_of(const any_tuple& tup) {
+        typedef typename std::tuple_element<Pos, Funs>::type fun_type;
+        return typed_case<fun_type>::matches(tup)
+               ? Pos
+               : typed_dispatch<Pos + 1, Size>::template index_of<Funs>(tup);
+    }
+};
+
+template<size_t Size>
+struct typed_dispatch<Size, Size> {
+    template<class Funs, class Table>
+    static inline void fill(Table&) { }
+    template<class Funs>
+    static inline size_t index_of(const any_tuple&) { return Size; }
+};
+
+template<typename... Fs>
+class typed_behavior_impl : public behavior_impl {
+
+    typedef std::tuple<Fs...> funs_type;
+
+    static constexpr size_t num_handlers = sizeof...(Fs);
+
+    typedef typed_dispatch<0, num_handlers> dispatch;
+
+    typedef void (*handler)(funs_type&, any_tuple&);
+
+    // maps type tokens to handler indexes; must be a power of two
+    static constexpr size_t cache_size = 8;
+
+    typedef std::pair<const std::type_info*, size_t> cache_entry;
+
+ public:
+
+    template<typename... Args>
+    typed_behavior_impl(Args&&... args) : m_funs(std::forward<Args>(args)...) {
+        // makes incoming remote messages statically typed
+        int unused[] = {0, (typed_case<Fs>::register_signature(), 0)...};
+        static_cast<void>(unused);
+        dispatch::template fill<funs_type>(m_handlers);
+        m_cache.fill(cache_entry{nullptr, num_handlers});
+    }
+
+    bool invoke(any_tuple& tup) {
+        auto i = index_of(tup);
+        if (i == num_handlers) return false;
+        m_handlers[i](m_funs, tup);
+        return true;
+    }
+
+    bool invoke(const any_tuple& tup) {
+        any_tuple tmp{tup};
+        return invoke(tmp);
+    }
+
+    bool defined_at(const any_tuple& tup) {
+        return index_of(tup) != num_handlers;
+    }
+
+ private:
+
+    // returns the index of the handler for tup or num_handlers;
+    // only the first message of each type compares the type lists
+    size_t index_of(const any_tuple& tup) {
+        if (tup.impl_type() != statically_typed) {
+            // the type token of a dynamically typed tuple
+            // does not identify its types
+            return dispatch::template index_of<funs_type>(tup);
+        }
+        auto token = tup.type_token();
+        auto& entry = m_cache[(reinterpret_cast<size_t>(token) >> 4)
+                              & (cache_size - 1)];
+        if (entry.first != token) {
+            entry.first = token;
+            entry.second = dispatch::template index_of<funs_type>(tup);
+        }
+        return entry.second;
+    }
+
+    funs_type m_funs;
+    std::array<handler, num_handlers> m_handlers;
+    std::array<cache_entry, cache_size> m_cache;
+
+};
+
+class typed_actor_impl : public event_based_actor {
+
+ public:
+
+    typed_actor_impl(behavior bhvr) : m_bhvr(std::move(bhvr)) { }
+
+    void init() { become(m_bhvr); }
+
+ private:
+
+    behavior m_bhvr;
+
+};
+
+} // namespace detail
+
+/**
+ * @brief Spawns an event-based actor from the given handlers. Each handler
+ *        defines one signature of the actor, e.g., the handler
+ *        <tt>[](int a, int b) { return a + b; }</tt> accepts messages
+ *        of type <tt>{int, int}</tt> and replies with the result.
+ * @returns A {@link typed_actor} handle to the spawned actor.
+ */
+template<typename... Fs>
+typed_actor<typename detail::typed_signature_of<Fs>::type...>
+spawn_typed(Fs... handlers) {
+    partial_function::impl_ptr ptr{
+        new detail::typed_behavior_impl<Fs...>(std::move(handlers)...)};
+    typedef typed_actor<typename detail::typed_signature_of<Fs>::type...>
+            result_type;
+    return result_type{spawn<detail::typed_actor_impl>(behavior{std::move(ptr)})};
+}
+
+/**
+ * @brief Sends <tt>{what...}</tt> as a message to @p whom.
+ *
+ * Fails to compile if @p whom does not accept messages of this type.
+ */
+template<typename... Signatures, typename... Args>
+void send(const typed_actor<Signatures...>& whom, Args&&... what) {
+    typedef util::type_list<
+                typename detail::strip_and_convert<Args>::type...>
+            args_type;
+    static_assert(detail::typed_accepts<args_type, Signatures...>::value,
+                  "typed_actor does not accept this message");
+    send_tuple(whom.address(), make_any_tuple(std::forward<Args>(what)...));
+}
+
+/**
+ * @brief Sends <tt>{what...}</tt> as a synchronous message to @p whom.
+ *
+ * Fails to compile if @p whom does not accept messages of this type.
+ * @returns A handle identifying a future to the response of @p whom.
+ */
+template<typename... Signatures, typename... Args>
+message_future sync_send(const typed_actor<Signatures...>& whom,
+                         Args&&... what) {
+    typedef util::type_list<
+                typename detail::strip_and_convert<Args>::type...>
+            args_type;
+    static_assert(detail::typed_accepts<args_type, Signatures...>::value,
+                  "typed_actor does not accept this message");
+    return sync_send_tuple(whom.address(),
+                           make_any_tuple(std::forward<Args>(what)...));
+}
+
+} // namespace cppa
+
+#endif // CPPA_TYPED_ACTOR_HPP
@@ -44,8 +44,11 @@
 #include "cppa/util/callable_trait.hpp"
 
 #include "cppa/detail/demangle.hpp"
+#include "cppa/detail/builtin_types.hpp"
 #include "cppa/detail/to_uniform_name.hpp"
 
+namespace cppa { namespace detail { class uniform_type_info_map; } }
+
 namespace cppa {
 
 class serializer;
@@ -148,6 +151,7 @@ const uniform_type_info* uniform_typeid(const std::type_info&);
 class uniform_type_info {
 
     friend class object;
+    friend class detail::uniform_type_info_map;
 
     friend bool operator==(const uniform_type_info& lhs,
                            const uniform_type_info& rhs);
@@ -180,6 +184,14 @@ class uniform_type_info {
      */
     static const uniform_type_info* from(const std::type_info& tinfo);
 
+    /**
+     * @brief Get instance by type ID.
+     * @param type_id The ID of an announced type.
+     * @returns The instance with <tt>id() == type_id</tt>.
+     * @throws std::runtime_error if no type with ID @p type_id was found.
+     */
+    static const uniform_type_info* from(std::uint32_t type_id);
+
     /**
      * @brief Get all instances.
      * @returns A vector with all known (announced) instances.
@@ -192,6 +204,15 @@ class uniform_type_info {
      */
     inline const std::string& name() const { return m_name; }
 
+    /**
+     * @brief Get the type ID of this type, which is assigned
+     *        when announcing it and dense, i.e., all announced types
+     *        have an ID in the range <tt>[0, instances().size())</tt>.
+     * @note Type IDs are local to a process and are not sent over network.
+     * @see type_id()
+     */
+    inline std::uint32_t id() const { return m_id; }
+
     /**
      * @brief Creates an object of this type.
      */
@@ -274,14 +295,45 @@ class uniform_type_info {
 
     std::string m_name;
 
+    std::uint32_t m_id;
+
 };
 
+/**
+ * @brief Returns the type ID of the built-in type @p T at compile time.
+ * @relates uniform_type_info
+ */
+template<typename T>
+constexpr std::uint32_t type_id() {
+    static_assert(detail::builtin_type_id<T>::value >= 0,
+                  "T is not a built-in type");
+    return static_cast<std::uint32_t>(detail::builtin_type_id<T>::value);
+}
+
+namespace detail {
+
+template<typename T, bool IsBuiltin = (builtin_type_id<T>::value >= 0)>
+struct uniform_typeid_helper {
+    static inline const uniform_type_info* get() {
+        return uniform_typeid(typeid(T));
+    }
+};
+
+template<typename T>
+struct uniform_typeid_helper<T, true> {
+    static inline const uniform_type_info* get() {
+        return uniform_type_info::from(type_id<T>());
+    }
+};
+
+} // namespace detail
+
 /**
  * @relates uniform_type_info
  */
 template<typename T>
 inline const uniform_type_info* uniform_typeid() {
-    return uniform_typeid(typeid(T));
+    return detail::uniform_typeid_helper<T>::get();
 }
 
 /**
@@ -31,6 +31,8 @@
 #ifndef CPPA_FIBER_HPP
 #define CPPA_FIBER_HPP
 
+#include <cstddef>
+
 namespace cppa { namespace util {
 
 class fiber_impl;
@@ -41,7 +43,10 @@ class fiber {
 
     fiber();
 
-    fiber(void (*func)(void*), void* arg1);
+    // executes func(arg1) on a stack with at least stack_size bytes;
+    // stack sizes are rounded up to a power of two (size class) and 0
+    // selects the default size, i.e., CPPA_FIBER_STACK_SIZE
+    fiber(void (*func)(void*), void* arg1, size_t stack_size = 0);
 
     ~fiber();
 
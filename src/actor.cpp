@@ -54,9 +54,11 @@ inline detail::actor_registry& registry() {
 
 } // namespace <anonymous>
 
-actor::actor(actor_id aid) : m_id(aid), m_is_proxy(true) { }
+actor::actor(actor_id aid)
+: m_id(aid), m_is_proxy(true), m_is_registered(false) { }
 
-actor::actor() : m_id(registry().next_id()), m_is_proxy(false) { }
+actor::actor()
+: m_id(registry().next_id()), m_is_proxy(false), m_is_registered(false) { }
 
 bool actor::chained_enqueue(actor* sender, any_tuple msg) {
     enqueue(sender, std::move(msg));
@@ -38,6 +38,10 @@ void inc_actor_count() {
     singleton_manager::get_actor_registry()->inc_running();
 }
 
+void inc_actor_count(size_t num) {
+    singleton_manager::get_actor_registry()->inc_running(num);
+}
+
 void dec_actor_count() {
     singleton_manager::get_actor_registry()->dec_running();
 }
@@ -47,4 +47,8 @@ namespace cppa {
 
 actor_proxy::actor_proxy(actor_id mid) : super(mid) { }
 
+void actor_proxy::link_exited(actor* sender, const any_tuple& exit_msg) {
+    enqueue(sender, exit_msg);
+}
+
 } // namespace cppa
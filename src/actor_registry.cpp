@@ -45,11 +45,31 @@ typedef std::lock_guard<cppa::util::shared_spinlock> exclusive_guard;
 typedef cppa::util::shared_lock_guard<cppa::util::shared_spinlock> shared_guard;
 typedef cppa::util::upgrade_lock_guard<cppa::util::shared_spinlock> upgrade_guard;
 
+// number of actor IDs a thread reserves at once
+constexpr std::uint32_t id_block_size = 1024;
+
+// denotes whether this thread reserves blocks of IDs
+__thread bool t_use_id_blocks = false;
+
+// next ID and end of the ID block reserved by this thread
+__thread std::uint32_t t_next_id = 0;
+__thread std::uint32_t t_id_block_end = 0;
+
+// index of this thread's shard of the running-actors-count plus one
+__thread size_t t_running_shard = 0;
+
+std::atomic<size_t> s_running_shard_ids{0};
+
 } // namespace <anonymous>
 
 namespace cppa { namespace detail {
 
-actor_registry::actor_registry() : m_running(0), m_ids(1) {
+actor_registry::actor_registry()
+: m_running_waiters(0), m_running_target(0), m_ids(1) {
+    for (auto& shard : m_running) {
+        shard.incs = 0;
+        shard.decs = 0;
+    }
 }
 
 actor_registry::value_type actor_registry::get_entry(actor_id key) const {
@@ -63,8 +83,10 @@ actor_registry::value_type actor_registry::get_entry(actor_id key) const {
 }
 
 void actor_registry::put(actor_id key, const actor_ptr& value) {
+    // fast path: actor already has an entry (or had one before it exited)
+    if (value == nullptr || value->is_registered()) return;
     bool add_attachable = false;
-    if (value != nullptr) {
+    { // lifetime scope of guard
         shared_guard guard(m_instances_mtx);
         auto i = m_entries.find(key);
         if (i == m_entries.end()) {
@@ -75,6 +97,9 @@ void actor_registry::put(actor_id key, const actor_ptr& value) {
             add_attachable = m_entries.insert(entry).second;
         }
     }
+    // the flag is set only *after* the entry exists, i.e., readers
+    // seeing it can safely skip this function altogether
+    value->m_is_registered.store(true, std::memory_order_release);
     if (add_attachable) {
         CPPA_LOG_INFO("added " << key);
         struct eraser : attachable {
@@ -104,24 +129,51 @@ void actor_registry::erase(actor_id key, std::uint32_t reason) {
 }
 
 std::uint32_t actor_registry::next_id() {
-    return m_ids.fetch_add(1);
+    if (!t_use_id_blocks) return m_ids.fetch_add(1);
+    if (t_next_id == t_id_block_end) {
+        t_next_id = m_ids.fetch_add(id_block_size);
+        t_id_block_end = t_next_id + id_block_size;
+    }
+    return t_next_id++;
+}
+
+void actor_registry::use_id_blocks() {
+    t_use_id_blocks = true;
+}
+
+actor_registry::running_shard& actor_registry::local_running_shard() {
+    if (t_running_shard == 0) {
+        t_running_shard = s_running_shard_ids.fetch_add(1) % num_running_shards + 1;
+    }
+    return m_running[t_running_shard - 1];
 }
 
 void actor_registry::inc_running() {
-    ++m_running;
+    local_running_shard().incs.fetch_add(1);
+}
+
+void actor_registry::inc_running(size_t num) {
+    local_running_shard().incs.fetch_add(num);
 }
 
 size_t actor_registry::running() const {
-    return m_running.load();
+    // all decrements are read before all increments, since each decrement
+    // happens after its increment, the result never underestimates
+    std::uint64_t decs = 0;
+    for (auto& shard : m_running) decs += shard.decs.load();
+    std::uint64_t incs = 0;
+    for (auto& shard : m_running) incs += shard.incs.load();
+    return static_cast<size_t>(incs - decs);
 }
 
 void actor_registry::dec_running() {
-    size_t new_val = --m_running;
-    /*
-    if (new_val == std::numeric_limits<size_t>::max()) {
-        throw std::underflow_error("actor_count::dec()");
-    }
-    else*/ if (new_val <= 1) {
+    local_running_shard().decs.fetch_add(1);
+    // the mutex is only touched if someone is waiting and the count
+    // might have reached the value that waiter is interested in;
+    // of several concurrent decrements, at least the last one
+    // sees the final count
+    if (   m_running_waiters.load() > 0
+        && running() <= m_running_target.load()) {
         std::unique_lock<std::mutex> guard(m_running_mtx);
         m_running_cv.notify_all();
     }
@@ -129,10 +181,21 @@ void actor_registry::dec_running() {
 
 void actor_registry::await_running_count_equal(size_t expected) {
     CPPA_LOG_TRACE(CPPA_ARG(expected));
-    std::unique_lock<std::mutex> guard(m_running_mtx);
-    while (m_running.load() != expected) {
-        m_running_cv.wait(guard);
+    // announce this waiter before reading the count, otherwise
+    // a concurrent dec_running() might skip the notification;
+    // the target never decreases, because waiters cannot safely
+    // withdraw it while another waiter might rely on it
+    m_running_waiters.fetch_add(1);
+    auto target = m_running_target.load();
+    while (target < expected
+           && !m_running_target.compare_exchange_weak(target, expected)) { }
+    {
+        std::unique_lock<std::mutex> guard(m_running_mtx);
+        while (running() != expected) {
+            m_running_cv.wait(guard);
+        }
     }
+    m_running_waiters.fetch_sub(1);
 }
 
 } } // namespace cppa::detail
@@ -28,6 +28,7 @@
 \******************************************************************************/
 
 
+#include "cppa/any_tuple.hpp"
 #include "cppa/attachable.hpp"
 
 namespace cppa {
@@ -35,4 +36,12 @@ namespace cppa {
 attachable::~attachable() {
 }
 
+void attachable::actor_exited(std::uint32_t reason, const any_tuple&) {
+    actor_exited(reason);
+}
+
+const void* attachable::token_ptr() const {
+    return nullptr;
+}
+
 } // namespace cppa::detail
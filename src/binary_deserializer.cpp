@@ -41,6 +41,8 @@
 #include "cppa/logging.hpp"
 #include "cppa/binary_deserializer.hpp"
 
+#include "cppa/detail/type_to_ptype.hpp"
+
 using namespace std;
 
 namespace cppa {
@@ -68,10 +70,7 @@ iterator read_range(iterator begin, iterator end, string& storage) {
     uint32_t str_size;
     begin = read_range(begin, end, str_size);
     range_check(begin, end, str_size);
-    storage.clear();
-    storage.reserve(str_size);
-    iterator cpy_end = begin + str_size;
-    copy(begin, cpy_end, back_inserter(storage));
+    storage.assign(begin, begin + str_size);
     return begin + str_size;
 }
 
@@ -186,4 +185,26 @@ void binary_deserializer::read_raw(size_t num_bytes, void* storage) {
     pos += num_bytes;
 }
 
+void binary_deserializer::read_raw_array(primitive_type ptype,
+                                         size_t num,
+                                         void* storage) {
+    auto esize = detail::integer_size(ptype);
+    if (esize > 0) read_raw(num * esize, storage);
+    else super::read_raw_array(ptype, num, storage);
+}
+
+void binary_deserializer::read_members(size_t num,
+                                       const primitive_type* ptypes,
+                                       void* const* storage) {
+    for (size_t i = 0; i < num; ++i) {
+        auto esize = detail::integer_size(ptypes[i]);
+        if (esize > 0) read_raw(esize, storage[i]);
+        else if (ptypes[i] == pt_u8string) {
+            // checks the string size against the remaining input
+            pos = read_range(pos, end, *reinterpret_cast<string*>(storage[i]));
+        }
+        else super::read_raw_array(ptypes[i], 1, storage[i]);
+    }
+}
+
 } // namespace cppa
@@ -38,6 +38,8 @@
 #include "cppa/primitive_variant.hpp"
 #include "cppa/binary_serializer.hpp"
 
+#include "cppa/detail/type_to_ptype.hpp"
+
 using std::enable_if;
 
 namespace cppa {
@@ -133,6 +135,32 @@ void binary_serializer::write_raw(size_t num_bytes, const void* data) {
     m_sink->write(num_bytes, data, grow_if_needed);
 }
 
+void binary_serializer::write_raw_array(primitive_type ptype,
+                                        size_t num,
+                                        const void* values) {
+    // integers are written in host byte order, i.e., an array of
+    // integers has the same representation as its elements written
+    // one by one; floating points and strings are written element-wise
+    auto esize = detail::integer_size(ptype);
+    if (esize > 0) m_sink->write(num * esize, values, grow_if_needed);
+    else super::write_raw_array(ptype, num, values);
+}
+
+void binary_serializer::write_members(size_t num,
+                                      const primitive_type* ptypes,
+                                      const void* const* values) {
+    // writes the same bytes as calling write_value for each member
+    for (size_t i = 0; i < num; ++i) {
+        auto esize = detail::integer_size(ptypes[i]);
+        if (esize > 0) m_sink->write(esize, values[i], grow_if_needed);
+        else if (ptypes[i] == pt_u8string) {
+            auto str = reinterpret_cast<const std::string*>(values[i]);
+            binary_writer::write_string(m_sink, *str);
+        }
+        else super::write_raw_array(ptypes[i], 1, values[i]);
+    }
+}
+
 void binary_serializer::write_tuple(size_t size,
                                     const primitive_variant* values) {
     const primitive_variant* end = values + size;
@@ -0,0 +1,99 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011, 2012                                                   *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation, either version 3 of the License                  *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+
+#include "cppa/coroutine_actor.hpp"
+#include "cppa/detail/behavior_impl.hpp"
+
+namespace cppa { namespace detail {
+
+// resumes the coroutine after the decorated behavior handled a message
+class coroutine_continuation : public behavior_impl {
+
+    typedef behavior_impl super;
+
+ public:
+
+    coroutine_continuation(coroutine_actor* self, behavior bhvr)
+    : super(bhvr.timeout()), m_self(self), m_decorated(std::move(bhvr)) { }
+
+    bool invoke(any_tuple& tup) {
+        return continue_if(m_decorated(tup));
+    }
+
+    bool invoke(const any_tuple& tup) {
+        return continue_if(m_decorated(tup));
+    }
+
+    bool defined_at(const any_tuple& tup) {
+        return m_decorated.defined_at(tup);
+    }
+
+    void handle_timeout() {
+        m_decorated.handle_timeout();
+        m_self->continue_run();
+    }
+
+ private:
+
+    inline bool continue_if(bool handled) {
+        if (handled) m_self->continue_run();
+        return handled;
+    }
+
+    coroutine_actor* m_self;
+    behavior m_decorated;
+
+};
+
+} // namespace detail
+
+coroutine_actor::coroutine_actor() : m_co_state(0) { }
+
+void coroutine_actor::init() {
+    run();
+}
+
+scheduled_actor_type coroutine_actor::impl_type() {
+    return coroutine_impl;
+}
+
+void coroutine_actor::do_co_receive(behavior bhvr) {
+    partial_function::impl_ptr ptr{
+        new detail::coroutine_continuation(this, std::move(bhvr))};
+    become(behavior{std::move(ptr)});
+}
+
+void coroutine_actor::continue_run() {
+    // a handler calling quit() ends the coroutine
+    if (has_behavior()) run();
+}
+
+} // namespace cppa
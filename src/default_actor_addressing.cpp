@@ -29,6 +29,7 @@
 
 
 #include <cstdint>
+#include <cstring>
 
 #include "cppa/logging.hpp"
 #include "cppa/to_string.hpp"
@@ -36,6 +37,7 @@
 #include "cppa/deserializer.hpp"
 #include "cppa/primitive_variant.hpp"
 
+#include "cppa/network/default_protocol.hpp"
 #include "cppa/network/default_actor_proxy.hpp"
 #include "cppa/network/default_actor_addressing.hpp"
 
@@ -47,7 +49,8 @@ using namespace std;
 namespace cppa { namespace network {
 
 default_actor_addressing::default_actor_addressing(default_protocol* parent)
-: m_parent(parent), m_pinf(process_information::get()) { }
+: m_parent(parent), m_pinf(process_information::get())
+, m_pid(m_pinf->process_id()), m_nid(m_pinf->node_id()) { }
 
 atom_value default_actor_addressing::technology_id() const {
     return atom("DEFAULT");
@@ -61,23 +64,31 @@ void default_actor_addressing::write(serializer* sink, const actor_ptr& ptr) {
         sink->end_object();
     }
     else {
-        // local actor?
-        if (!ptr->is_proxy()) {
-            detail::singleton_manager::get_actor_registry()->put(ptr->id(), ptr);
-        }
-        auto pinf = m_pinf;
+        auto pinf = m_pinf.get();
         if (ptr->is_proxy()) {
             auto dptr = ptr.downcast<default_actor_proxy>();
-            if (dptr) pinf = dptr->process_info();
+            if (dptr) pinf = dptr->process_info().get();
             else {
                 CPPA_LOG_ERROR("ptr is not a default_actor_proxy instance");
             }
         }
+        // local actors need an entry in the registry to be addressable
+        // from remote nodes; the registry only needs to be consulted
+        // once per actor since the flag never gets cleared
+        else if (!ptr->is_registered()) {
+            detail::singleton_manager::get_actor_registry()->put(ptr->id(), ptr);
+        }
         sink->begin_object("@actor");
         sink->write_value(ptr->id());
-        sink->write_value(pinf->process_id());
-        sink->write_raw(process_information::node_id_size,
-                        pinf->node_id().data());
+        if (pinf == m_pinf.get()) {
+            sink->write_value(m_pid);
+            sink->write_raw(process_information::node_id_size, m_nid.data());
+        }
+        else {
+            sink->write_value(pinf->process_id());
+            sink->write_raw(process_information::node_id_size,
+                            pinf->node_id().data());
+        }
         sink->end_object();
     }
 }
@@ -99,85 +110,216 @@ actor_ptr default_actor_addressing::read(deserializer* source) {
         source->read_raw(process_information::node_id_size, nid.data());
         source->end_object();
         // local actor?
-        auto pinf = process_information::get();
-        if (pid == pinf->process_id() && nid == pinf->node_id()) {
+        if (pid == m_pid && nid == m_nid) {
             return detail::singleton_manager::get_actor_registry()->get(aid);
         }
         else {
-            process_information tmp(pid, nid);
-            return get_or_put(tmp, aid);
+            return get_or_put(intern(process_information(pid, nid)), aid);
         }
     }
     else throw runtime_error("expected type name \"@0\" or \"@actor\"; "
                              "found: " + cname);
 }
 
+size_t default_actor_addressing::node_hash::operator()(const process_information& node) const {
+    // node ids are RIPEMD-160 hashes, i.e., any 8 bytes are
+    // as good as a hash value as all 20 bytes
+    std::uint64_t result;
+    memcpy(&result, node.node_id().data(), sizeof(std::uint64_t));
+    return static_cast<size_t>(result ^ node.process_id());
+}
+
+auto default_actor_addressing::handle_of(const process_information& node) const
+-> node_handle {
+    auto i = m_handles.find(node);
+    return (i != m_handles.end()) ? i->second : invalid_handle;
+}
+
+auto default_actor_addressing::intern(const process_information& node)
+-> node_handle {
+    auto i = m_handles.find(node);
+    if (i != m_handles.end()) return i->second;
+    node_handle result;
+    if (m_free_handles.empty()) {
+        result = static_cast<node_handle>(m_nodes.size());
+        m_nodes.push_back(node_entry{new process_information(node), {}, {}});
+    }
+    else {
+        result = m_free_handles.back();
+        m_free_handles.pop_back();
+        m_nodes[result] = node_entry{new process_information(node), {}, {}};
+    }
+    m_handles.insert(make_pair(node, result));
+    CPPA_LOG_DEBUG("interned " << to_string(node) << " as " << result);
+    return result;
+}
+
 size_t default_actor_addressing::count_proxies(const process_information& inf) {
-    auto i = m_proxies.find(inf);
-    return (i != m_proxies.end()) ? i->second.size() : 0;
+    auto h = handle_of(inf);
+    return (h != invalid_handle) ? m_nodes[h].aids.size() : 0;
 }
 
-actor_ptr default_actor_addressing::get(const process_information& inf,
-                                        actor_id aid) {
-    auto& submap = m_proxies[inf];
-    auto i = submap.find(aid);
-    if (i != submap.end()) {
+actor_proxy_ptr default_actor_addressing::get(node_handle h, actor_id aid) {
+    auto i = m_proxies.find(key_of(h, aid));
+    if (i != m_proxies.end()) {
         auto result = i->second.promote();
         CPPA_LOG_INFO_IF(!result, "proxy instance expired; "
-                                  << CPPA_TARG(inf, to_string) << ", "
-                                  << CPPA_ARG(aid));
+                                  << CPPA_TARG(*m_nodes[h].info, to_string)
+                                  << ", " << CPPA_ARG(aid));
         return result;
     }
     return nullptr;
 }
 
-void default_actor_addressing::put(const process_information& node,
+actor_ptr default_actor_addressing::get(const process_information& inf,
+                                        actor_id aid) {
+    auto h = handle_of(inf);
+    if (h != invalid_handle) return get(h, aid);
+    return nullptr;
+}
+
+void default_actor_addressing::put(node_handle h,
                                    actor_id aid,
                                    const actor_proxy_ptr& proxy) {
-    auto& submap = m_proxies[node];
-    auto i = submap.find(aid);
-    if (i == submap.end()) {
-        submap.insert(make_pair(aid, proxy));
-        m_parent->enqueue(node,
-                          {nullptr, nullptr},
-                          make_any_tuple(atom("MONITOR"),
-                                         process_information::get(),
-                                         aid));
+    auto& entry = m_nodes[h];
+    auto res = m_proxies.insert(make_pair(key_of(h, aid),
+                                          weak_actor_proxy_ptr{proxy}));
+    if (res.second) {
+        entry.aids.insert(aid);
+        // MONITOR requests are collected and sent as a single message
+        // once the middleman is done with its current task, because
+        // deserializing one message might create any number of proxies
+        entry.pending_monitors.push_back(aid);
+        if (entry.pending_monitors.size() == 1) {
+            default_protocol_ptr proto = m_parent;
+            auto node = entry.info;
+            m_parent->run_later([proto, node] {
+                CPPA_LOGF_TRACE("lambda from default_actor_addressing::put");
+                proto->addressing()->flush_monitors(*node);
+            });
+        }
+    }
+    else if (res.first->second.promote() == nullptr) {
+        // replace expired instance, whose destructor will
+        // try to erase its entry later on
+        res.first->second = proxy;
     }
     else {
-        CPPA_LOG_ERROR("a proxy for " << aid << ":" << to_string(node)
+        CPPA_LOG_ERROR("a proxy for " << aid << ":" << to_string(*entry.info)
                        << " already exists");
     }
 }
 
+void default_actor_addressing::put(const process_information& node,
+                                   actor_id aid,
+                                   const actor_proxy_ptr& proxy) {
+    put(intern(node), aid, proxy);
+}
 
-actor_ptr default_actor_addressing::get_or_put(const process_information& inf,
-                                               actor_id aid) {
-    auto result = get(inf, aid);
+actor_ptr default_actor_addressing::get_or_put(node_handle h, actor_id aid) {
+    actor_ptr result = get(h, aid);
     if (result == nullptr) {
+        auto& pinf = m_nodes[h].info;
         CPPA_LOG_INFO("created new proxy instance; "
-                      << CPPA_TARG(inf, to_string) << ", " << CPPA_ARG(aid));
-        auto ptr = make_counted<default_actor_proxy>(aid, new process_information(inf), m_parent);
-        put(inf, aid, ptr);
+                      << CPPA_TARG(*pinf, to_string) << ", " << CPPA_ARG(aid));
+        auto ptr = make_counted<default_actor_proxy>(aid, pinf, m_parent);
+        put(h, aid, ptr);
         result = ptr;
     }
     return result;
 }
 
-auto default_actor_addressing::proxies(process_information& i) -> proxy_map& {
-    return m_proxies[i];
+actor_ptr default_actor_addressing::get_or_put(const process_information& inf,
+                                               actor_id aid) {
+    return get_or_put(intern(inf), aid);
+}
+
+vector<actor_proxy_ptr>
+default_actor_addressing::proxies(const process_information& inf) {
+    vector<actor_proxy_ptr> result;
+    auto h = handle_of(inf);
+    if (h != invalid_handle) {
+        auto& aids = m_nodes[h].aids;
+        result.reserve(aids.size());
+        for (auto aid : aids) {
+            auto i = m_proxies.find(key_of(h, aid));
+            CPPA_REQUIRE(i != m_proxies.end());
+            auto ptr = i->second.promote();
+            if (ptr) result.push_back(move(ptr));
+        }
+    }
+    return result;
+}
+
+void default_actor_addressing::release(handle_map::iterator i) {
+    auto h = i->second;
+    m_nodes[h] = node_entry{nullptr, {}, {}};
+    m_free_handles.push_back(h);
+    m_handles.erase(i);
 }
 
-void default_actor_addressing::erase(process_information& inf) {
+void default_actor_addressing::erase(const process_information& inf) {
     CPPA_LOG_TRACE("inf = " << to_string(inf));
-    m_proxies.erase(inf);
+    auto i = m_handles.find(inf);
+    if (i != m_handles.end()) {
+        auto h = i->second;
+        for (auto aid : m_nodes[h].aids) m_proxies.erase(key_of(h, aid));
+        release(i);
+    }
 }
 
-void default_actor_addressing::erase(process_information& inf, actor_id aid) {
+void default_actor_addressing::kill_proxies(const process_information& inf,
+                                            std::uint32_t reason) {
+    CPPA_LOG_TRACE("inf = " << to_string(inf) << ", " << CPPA_ARG(reason));
+    // inf might be owned by one of the proxies we are about to kill
+    auto node = inf;
+    auto h = handle_of(node);
+    if (h == invalid_handle) return;
+    vector<actor_proxy_ptr> victims;
+    victims.reserve(m_nodes[h].aids.size());
+    for (auto aid : m_nodes[h].aids) {
+        auto i = m_proxies.find(key_of(h, aid));
+        CPPA_REQUIRE(i != m_proxies.end());
+        auto ptr = i->second.promote();
+        if (ptr) victims.push_back(move(ptr));
+        m_proxies.erase(i);
+    }
+    m_nodes[h].aids.clear();
+    // all proxies share a single message
+    auto msg = make_any_tuple(atom("KILL_PROXY"), reason);
+    // enqueueing KILL_PROXY might run arbitrary code, i.e., neither
+    // h nor any iterator to m_handles is guaranteed to be valid afterwards
+    for (auto& ptr : victims) ptr->enqueue(nullptr, msg);
+    auto i = m_handles.find(node);
+    if (i != m_handles.end() && m_nodes[i->second].aids.empty()) release(i);
+}
+
+void default_actor_addressing::flush_monitors(const process_information& inf) {
+    auto h = handle_of(inf);
+    if (h == invalid_handle) return; // node was erased in the meantime
+    std::vector<actor_id> aids;
+    aids.swap(m_nodes[h].pending_monitors);
+    CPPA_LOG_TRACE("inf = " << to_string(inf) << ", " << aids.size() << " aids");
+    if (!aids.empty()) {
+        m_parent->enqueue(inf,
+                          {nullptr, nullptr, message_id_t::invalid,
+                           message_header::control_frame},
+                          make_control_msg(message_header::monitor_op,
+                                           move(aids)));
+    }
+}
+
+void default_actor_addressing::erase(const process_information& inf,
+                                     actor_id aid) {
     CPPA_LOG_TRACE("inf = " << to_string(inf) << ", aid = " << aid);
-    auto i = m_proxies.find(inf);
-    if (i != m_proxies.end()) {
-        i->second.erase(aid);
+    auto h = handle_of(inf);
+    if (h != invalid_handle) {
+        auto i = m_proxies.find(key_of(h, aid));
+        // an expired entry might have been replaced by a new instance
+        if (i != m_proxies.end() && i->second.promote() == nullptr) {
+            m_proxies.erase(i);
+            m_nodes[h].aids.erase(aid);
+        }
     }
 }
 
@@ -64,9 +64,12 @@ default_actor_proxy::~default_actor_proxy() {
     });
 }
 
-void default_actor_proxy::forward_msg(const actor_ptr& sender, any_tuple msg, message_id_t mid) {
+void default_actor_proxy::forward_msg(const actor_ptr& sender,
+                                      any_tuple msg,
+                                      message_id_t mid,
+                                      message_header::frame_type type) {
     CPPA_LOG_TRACE("");
-    message_header hdr{sender, this, mid};
+    message_header hdr{sender, this, mid, type};
     auto node = m_pinf;
     auto proto = m_proto;
     m_proto->run_later([hdr, msg, node, proto] {
@@ -89,6 +92,24 @@ void default_actor_proxy::enqueue(actor* sender, any_tuple msg) {
     forward_msg(sender, move(msg));
 }
 
+void default_actor_proxy::link_exited(actor* sender, const any_tuple& exit_msg) {
+    CPPA_LOG_TRACE(CPPA_ARG(sender) << ", " << CPPA_TARG(exit_msg, to_string));
+    message_header hdr{sender, this, message_id_t(), message_header::user_frame};
+    auto node = m_pinf;
+    auto proto = m_proto;
+    m_proto->run_later([hdr, exit_msg, node, proto] {
+        CPPA_LOGF_TRACE("lambda from default_actor_proxy::link_exited");
+        // the peer sends all exit messages of the sender as one message
+        auto p = proto->get_peer(*node);
+        if (p) {
+            p->exit_later(hdr.sender,
+                          hdr.receiver->id(),
+                          exit_msg.get_as<std::uint32_t>(1));
+        }
+        else proto->enqueue(*node, hdr, exit_msg);
+    });
+}
+
 void default_actor_proxy::sync_enqueue(actor* sender, message_id_t mid, any_tuple msg) {
     CPPA_LOG_TRACE(CPPA_ARG(sender) << ", " << CPPA_MARG(mid, integer_value)
                    << ", " << CPPA_TARG(msg, to_string));
@@ -100,7 +121,7 @@ void default_actor_proxy::link_to(const intrusive_ptr<actor>& other) {
     if (link_to_impl(other)) {
         // causes remote actor to link to (proxy of) other
         // receiving peer will call: this->local_link_to(other)
-        forward_msg(this, make_any_tuple(atom("LINK"), other));
+        forward_control_msg(make_control_msg(message_header::link_op, other));
     }
 }
 
@@ -108,7 +129,7 @@ void default_actor_proxy::unlink_from(const intrusive_ptr<actor>& other) {
     CPPA_LOG_TRACE(CPPA_MARG(other, get));
     if (unlink_from_impl(other)) {
         // causes remote actor to unlink from (proxy of) other
-        forward_msg(this, make_any_tuple(atom("UNLINK"), other));
+        forward_control_msg(make_control_msg(message_header::unlink_op, other));
     }
 }
 
@@ -116,7 +137,7 @@ bool default_actor_proxy::establish_backlink(const intrusive_ptr<actor>& other)
     CPPA_LOG_TRACE(CPPA_MARG(other, get));
     if (super::establish_backlink(other)) {
         // causes remote actor to unlink from (proxy of) other
-        forward_msg(this, make_any_tuple(atom("LINK"), other));
+        forward_control_msg(make_control_msg(message_header::link_op, other));
         return true;
     }
     return false;
@@ -126,7 +147,7 @@ bool default_actor_proxy::remove_backlink(const intrusive_ptr<actor>& other) {
     CPPA_LOG_TRACE(CPPA_MARG(other, get));
     if (super::remove_backlink(other)) {
         // causes remote actor to unlink from (proxy of) other
-        forward_msg(this, make_any_tuple(atom("UNLINK"), other));
+        forward_control_msg(make_control_msg(message_header::unlink_op, other));
         return true;
     }
     return false;
@@ -28,12 +28,11 @@
 \******************************************************************************/
 
 
+#include <string>
 #include <cstring>
 #include <cstdint>
 
-#include "cppa/on.hpp"
 #include "cppa/actor.hpp"
-#include "cppa/match.hpp"
 #include "cppa/logging.hpp"
 #include "cppa/to_string.hpp"
 #include "cppa/exit_reason.hpp"
@@ -62,9 +61,12 @@ default_peer::default_peer(default_protocol* parent,
 , m_parent(parent), m_in(in), m_out(out)
 , m_state((peer_ptr) ? wait_for_msg_size : wait_for_process_info)
 , m_node(peer_ptr)
-, m_has_unwritten_data(false) {
+, m_has_unwritten_data(false)
+, m_unflushed_messages(0)
+, m_flush_scheduled(false)
+, m_flush_epoch(0) {
     m_rd_buf.reset(m_state == wait_for_process_info
-                   ? sizeof(uint32_t) + process_information::node_id_size
+                   ? 2 * sizeof(uint32_t) + process_information::node_id_size
                    : sizeof(uint32_t));
     // state == wait_for_msg_size iff peer was created using remote_peer()
     // in this case, this peer must be erased if no proxy of it remains
@@ -81,14 +83,8 @@ void default_peer::disconnected() {
     CPPA_LOG_TRACE("node = " << (m_node ? to_string(*m_node) : "nullptr"));
     if (m_node) {
         // kill all proxies
-        auto& children = m_parent->addressing()->proxies(*m_node);
-        for (auto& kvp : children) {
-            auto ptr = kvp.second.promote();
-            if (ptr) ptr->enqueue(nullptr,
-                                  make_any_tuple(atom("KILL_PROXY"),
-                                      exit_reason::remote_link_unreachable));
-        }
-        m_parent->addressing()->erase(*m_node);
+        m_parent->addressing()->kill_proxies(*m_node,
+                                             exit_reason::remote_link_unreachable);
     }
 }
 
@@ -110,10 +106,20 @@ continue_reading_result default_peer::continue_reading() {
             case wait_for_process_info: {
                 //DEBUG("peer_connection::continue_reading: "
                 //      "wait_for_process_info");
+                uint32_t version;
                 uint32_t process_id;
                 process_information::node_id_type node_id;
-                memcpy(&process_id, m_rd_buf.data(), sizeof(uint32_t));
-                memcpy(node_id.data(), m_rd_buf.data() + sizeof(uint32_t),
+                auto data = m_rd_buf.data();
+                memcpy(&version, data, sizeof(uint32_t));
+                if (version != default_protocol::wire_format_version) {
+                    CPPA_LOG_ERROR("incompatible wire format: " << version);
+                    std::cerr << "*** middleman warning: incoming connection "
+                                 "uses an incompatible wire format"
+                              << std::endl;
+                    return read_failure;
+                }
+                memcpy(&process_id, data + sizeof(uint32_t), sizeof(uint32_t));
+                memcpy(node_id.data(), data + 2 * sizeof(uint32_t),
                        process_information::node_id_size);
                 m_node.reset(new process_information(process_id, node_id));
                 if (*process_information::get() == *m_node) {
@@ -145,7 +151,13 @@ continue_reading_result default_peer::continue_reading() {
                                        m_parent->addressing());
                 try {
                     m_meta_hdr->deserialize(&hdr, &bd);
-                    m_meta_msg->deserialize(&msg, &bd);
+                    // control messages use their own encoding and are
+                    // processed right away; all other messages are
+                    // delivered without inspecting their content
+                    if (hdr.type == message_header::control_frame) {
+                        read_control_msg(hdr, &bd);
+                    }
+                    else m_meta_msg->deserialize(&msg, &bd);
                 }
                 catch (exception& e) {
                     CPPA_LOG_ERROR("exception during read_message: "
@@ -153,28 +165,11 @@ continue_reading_result default_peer::continue_reading() {
                                    << ", what(): " << e.what());
                     return read_failure;
                 }
-                CPPA_LOG_DEBUG("deserialized: " << to_string(hdr) << " " << to_string(msg));
-                //DEBUG("<-- " << to_string(msg));
-                match(msg) (
-                    // monitor messages are sent automatically whenever
-                    // actor_proxy_cache creates a new proxy
-                    // note: aid is the *original* actor id
-                    on(atom("MONITOR"), arg_match) >> [&](const process_information_ptr& node, actor_id aid) {
-                        monitor(hdr.sender, node, aid);
-                    },
-                    on(atom("KILL_PROXY"), arg_match) >> [&](const process_information_ptr& node, actor_id aid, std::uint32_t reason) {
-                        kill_proxy(hdr.sender, node, aid, reason);
-                    },
-                    on(atom("LINK"), arg_match) >> [&](const actor_ptr& ptr) {
-                        link(hdr.sender, ptr);
-                    },
-                    on(atom("UNLINK"), arg_match) >> [&](const actor_ptr& ptr) {
-                        unlink(hdr.sender, ptr);
-                    },
-                    others() >> [&] {
-                        deliver(hdr, move(msg));
-                    }
-                );
+                if (hdr.type == message_header::user_frame) {
+                    CPPA_LOG_DEBUG("deserialized: " << to_string(hdr)
+                                   << " " << to_string(msg));
+                    deliver(hdr, move(msg));
+                }
                 m_rd_buf.reset(sizeof(uint32_t));
                 m_state = wait_for_msg_size;
                 break;
@@ -187,6 +182,101 @@ continue_reading_result default_peer::continue_reading() {
     }
 }
 
+void default_peer::read_control_msg(const message_header& hdr,
+                                    deserializer* source) {
+    auto op = source->read<std::uint8_t>();
+    switch (op) {
+        case message_header::monitor_op: {
+            // note: aids are the *original* actor ids
+            auto num = source->begin_sequence();
+            for (size_t i = 0; i < num; ++i) {
+                monitor(hdr.sender, m_node, source->read<actor_id>());
+            }
+            source->end_sequence();
+            break;
+        }
+        case message_header::kill_proxy_op: {
+            auto num = source->begin_sequence();
+            for (size_t i = 0; i < num; ++i) {
+                auto aid = source->read<actor_id>();
+                auto reason = source->read<std::uint32_t>();
+                kill_proxy(hdr.sender, m_node, aid, reason);
+            }
+            source->end_sequence();
+            break;
+        }
+        case message_header::link_op: {
+            link(hdr.sender, m_parent->addressing()->read(source));
+            break;
+        }
+        case message_header::unlink_op: {
+            unlink(hdr.sender, m_parent->addressing()->read(source));
+            break;
+        }
+        case message_header::exit_op: {
+            auto reason = source->read<std::uint32_t>();
+            // all receivers share a single message
+            auto msg = make_any_tuple(atom("EXIT"), reason);
+            auto registry = detail::singleton_manager::get_actor_registry();
+            auto num = source->begin_sequence();
+            for (size_t i = 0; i < num; ++i) {
+                auto receiver = registry->get(source->read<actor_id>());
+                if (receiver) receiver->enqueue(hdr.sender.get(), msg);
+                else CPPA_LOG_DEBUG("EXIT for an unknown or exited actor");
+            }
+            source->end_sequence();
+            break;
+        }
+        default: {
+            throw runtime_error("invalid control message opcode: "
+                                + std::to_string(static_cast<int>(op)));
+        }
+    }
+}
+
+void default_peer::write_control_msg(serializer* sink, const any_tuple& msg) {
+    CPPA_REQUIRE(msg.size() > 0 && msg.type_at(0) == uniform_typeid<std::uint8_t>());
+    auto op = msg.get_as<std::uint8_t>(0);
+    sink->write_value(op);
+    switch (op) {
+        case message_header::monitor_op: {
+            auto& aids = msg.get_as<vector<actor_id>>(1);
+            sink->begin_sequence(aids.size());
+            for (auto aid : aids) sink->write_value(aid);
+            sink->end_sequence();
+            break;
+        }
+        case message_header::kill_proxy_op: {
+            auto& aids = msg.get_as<vector<actor_id>>(1);
+            auto& reasons = msg.get_as<vector<std::uint32_t>>(2);
+            CPPA_REQUIRE(aids.size() == reasons.size());
+            sink->begin_sequence(aids.size());
+            for (size_t i = 0; i < aids.size(); ++i) {
+                sink->write_value(aids[i]);
+                sink->write_value(reasons[i]);
+            }
+            sink->end_sequence();
+            break;
+        }
+        case message_header::link_op:
+        case message_header::unlink_op: {
+            m_parent->addressing()->write(sink, msg.get_as<actor_ptr>(1));
+            break;
+        }
+        case message_header::exit_op: {
+            auto& aids = msg.get_as<vector<actor_id>>(2);
+            sink->write_value(msg.get_as<std::uint32_t>(1));
+            sink->begin_sequence(aids.size());
+            for (auto aid : aids) sink->write_value(aid);
+            sink->end_sequence();
+            break;
+        }
+        default: {
+            throw logic_error("invalid control message: " + to_string(msg));
+        }
+    }
+}
+
 void default_peer::monitor(const actor_ptr&,
                            const process_information_ptr& node,
                            actor_id aid) {
@@ -212,8 +302,7 @@ void default_peer::monitor(const actor_ptr&,
                            "execution; reply KILL_PROXY");
             // this actor already finished execution;
             // reply with KILL_PROXY message
-            // get corresponding peer
-            enqueue(make_any_tuple(atom("KILL_PROXY"), pself, aid, entry.second));
+            kill_proxy_later(aid, entry.second);
         }
     }
     else {
@@ -223,12 +312,80 @@ void default_peer::monitor(const actor_ptr&,
             proto->run_later([=] {
                 CPPA_LOGF_TRACE("lambda from default_peer::monitor");
                 auto p = proto->get_peer(*node);
-                if (p) p->enqueue(make_any_tuple(atom("KILL_PROXY"), pself, aid, reason));
+                if (p) p->kill_proxy_later(aid, reason);
             });
         });
     }
 }
 
+void default_peer::kill_proxy_later(actor_id aid, std::uint32_t reason) {
+    CPPA_LOG_TRACE(CPPA_ARG(aid) << ", " << CPPA_ARG(reason));
+    m_pending_kills.push_back(aid);
+    m_pending_kill_reasons.push_back(reason);
+    if (m_pending_kills.size() == 1) {
+        // actors usually exit in groups, e.g., on shutdown of a node;
+        // collect all notifications that are already queued in the
+        // middleman to send them as a single message
+        default_peer_ptr pptr = this;
+        m_parent->run_later([pptr] {
+            CPPA_LOGF_TRACE("lambda from default_peer::kill_proxy_later");
+            pptr->flush_kill_proxies();
+        });
+    }
+}
+
+void default_peer::flush_kill_proxies() {
+    CPPA_LOG_TRACE(CPPA_ARG(m_pending_kills.size()));
+    vector<actor_id> aids;
+    vector<std::uint32_t> reasons;
+    aids.swap(m_pending_kills);
+    reasons.swap(m_pending_kill_reasons);
+    if (!aids.empty()) {
+        enqueue_control(make_control_msg(message_header::kill_proxy_op,
+                                         move(aids),
+                                         move(reasons)));
+    }
+}
+
+void default_peer::exit_later(const actor_ptr& sender,
+                              actor_id aid,
+                              std::uint32_t reason) {
+    CPPA_LOG_TRACE(CPPA_MARG(sender, get) << ", " << CPPA_ARG(aid)
+                   << ", " << CPPA_ARG(reason));
+    bool flush_scheduled = !m_pending_exits.empty();
+    if (   flush_scheduled
+        && m_pending_exits.back().sender == sender
+        && m_pending_exits.back().reason == reason) {
+        m_pending_exits.back().receivers.push_back(aid);
+    }
+    else m_pending_exits.push_back(pending_exit{sender, reason, {aid}});
+    if (!flush_scheduled) {
+        // an actor enqueues the exit messages to all of its links at once,
+        // i.e., they are already queued in the middleman at this point
+        default_peer_ptr pptr = this;
+        m_parent->run_later([pptr] {
+            CPPA_LOGF_TRACE("lambda from default_peer::exit_later");
+            pptr->flush_exits();
+        });
+    }
+}
+
+void default_peer::flush_exits() {
+    CPPA_LOG_TRACE(CPPA_ARG(m_pending_exits.size()));
+    vector<pending_exit> exits;
+    exits.swap(m_pending_exits);
+    for (auto& e : exits) {
+        // use the protocol to keep the order of messages already
+        // queued for this peer, e.g., the last messages of e.sender
+        m_parent->enqueue(*m_node,
+                          {e.sender, nullptr, message_id_t::invalid,
+                           message_header::control_frame},
+                          make_control_msg(message_header::exit_op,
+                                           e.reason,
+                                           move(e.receivers)));
+    }
+}
+
 void default_peer::kill_proxy(const actor_ptr& sender,
                               const process_information_ptr& node,
                               actor_id aid,
@@ -346,7 +503,9 @@ continue_writing_result default_peer::continue_writing() {
             enqueue(tmp.first, tmp.second);
         }
     }
-    if (erase_on_last_proxy_exited() && !has_unwritten_data()) {
+    if (   erase_on_last_proxy_exited()
+        && !has_unwritten_data()
+        && !has_buffered_data()) {
         if (m_parent->addressing()->count_proxies(*m_node) == 0) {
             m_parent->last_proxy_exited(this);
         }
@@ -364,7 +523,13 @@ void default_peer::enqueue(const message_header& hdr, const any_tuple& msg) {
     uint32_t size = 0;
     auto before = m_wr_buf.size();
     m_wr_buf.write(sizeof(uint32_t), &size, util::grow_if_needed);
-    try { bs << hdr << msg; }
+    try {
+        m_meta_hdr->serialize(&hdr, &bs);
+        if (hdr.type == message_header::control_frame) {
+            write_control_msg(&bs, msg);
+        }
+        else m_meta_msg->serialize(&msg, &bs);
+    }
     catch (exception& e) {
         CPPA_LOG_ERROR(to_verbose_string(e));
         cerr << "*** exception in default_peer::enqueue; "
@@ -378,7 +543,38 @@ void default_peer::enqueue(const message_header& hdr, const any_tuple& msg) {
     memcpy(m_wr_buf.data() + before, &size, sizeof(std::uint32_t));
     CPPA_LOG_DEBUG_IF(m_has_unwritten_data, "still registered for writing");
     if (!m_has_unwritten_data) {
+        ++m_unflushed_messages;
+        auto& policy = m_parent->coalescing();
+        if (   m_wr_buf.size() >= policy.max_bytes
+            || m_unflushed_messages >= policy.max_messages) {
+            flush();
+        }
+        else if (!m_flush_scheduled) {
+            CPPA_LOG_DEBUG("schedule flush");
+            m_flush_scheduled = true;
+            default_peer_ptr pptr = this;
+            auto epoch = m_flush_epoch;
+            m_parent->run_delayed(policy.max_delay, [pptr, epoch] {
+                CPPA_LOGF_TRACE("lambda from default_peer::enqueue");
+                // the buffer was flushed in the meantime if the epoch
+                // differs, i.e., a later message might be pending with
+                // a shorter delay
+                if (pptr->m_flush_epoch == epoch) {
+                    pptr->m_flush_scheduled = false;
+                    pptr->flush();
+                }
+            });
+        }
+    }
+}
+
+void default_peer::flush() {
+    CPPA_LOG_TRACE("");
+    if (!m_has_unwritten_data && !m_wr_buf.empty()) {
         CPPA_LOG_DEBUG("register for writing");
+        m_unflushed_messages = 0;
+        m_flush_scheduled = false;
+        ++m_flush_epoch;
         m_has_unwritten_data = true;
         m_parent->continue_writer(this);
     }
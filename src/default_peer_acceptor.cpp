@@ -63,9 +63,11 @@ continue_reading_result default_peer_acceptor::continue_reading() {
         if (opt) {
             auto& pair = *opt;
             auto& pself = process_information::get();
+            uint32_t version = default_protocol::wire_format_version;
             uint32_t process_id = pself->process_id();
             try {
                 actor_id aid = published_actor()->id();
+                pair.second->write(&version, sizeof(uint32_t));
                 pair.second->write(&aid, sizeof(actor_id));
                 pair.second->write(&process_id, sizeof(uint32_t));
                 pair.second->write(pself->node_id().data(),
@@ -33,6 +33,7 @@
 #include <iostream>
 
 #include "cppa/logging.hpp"
+#include "cppa/exception.hpp"
 #include "cppa/to_string.hpp"
 
 #include "cppa/network/middleman.hpp"
@@ -40,6 +41,7 @@
 #include "cppa/network/ipv4_acceptor.hpp"
 #include "cppa/network/ipv4_io_stream.hpp"
 #include "cppa/network/default_protocol.hpp"
+#include "cppa/network/default_actor_proxy.hpp"
 #include "cppa/network/default_peer_acceptor.hpp"
 
 #include "cppa/detail/actor_registry.hpp"
@@ -119,7 +121,10 @@ void default_protocol::register_peer(const process_information& node,
         if (entry.queue == nullptr) entry.queue.emplace();
         ptr->set_queue(entry.queue);
         entry.impl.reset(ptr);
-        if (!entry.queue->empty()) {
+        // note: enqueue might not register the peer for writing
+        //       because of the coalescing policy, hence we have
+        //       to move all queued messages to the peer's buffer
+        while (!entry.queue->empty()) {
             auto tmp = entry.queue->pop();
             ptr->enqueue(tmp.first, tmp.second);
         }
@@ -174,13 +179,21 @@ actor_ptr default_protocol::remote_actor(io_stream_ptr_pair io,
     CPPA_REQUIRE(args.size() == 0);
     static_cast<void>(args); // keep compiler happy when compiling w/o debug
     auto pinf = process_information::get();
+    std::uint32_t version = wire_format_version;
     std::uint32_t process_id = pinf->process_id();
     // throws on error
+    io.second->write(&version, sizeof(std::uint32_t));
     io.second->write(&process_id, sizeof(std::uint32_t));
     io.second->write(pinf->node_id().data(), pinf->node_id().size());
     actor_id remote_aid;
     std::uint32_t peer_pid;
     process_information::node_id_type peer_node_id;
+    io.first->read(&version, sizeof(std::uint32_t));
+    if (version != wire_format_version) {
+        CPPA_LOG_ERROR("peer uses an incompatible wire format: " << version);
+        throw network_error("remote_actor: peer uses an incompatible "
+                            "wire format");
+    }
     io.first->read(&remote_aid, sizeof(actor_id));
     io.first->read(&peer_pid, sizeof(std::uint32_t));
     io.first->read(peer_node_id.data(), peer_node_id.size());
@@ -213,7 +226,9 @@ void default_protocol::last_proxy_exited(const default_peer_ptr& pptr) {
     CPPA_REQUIRE(pptr != nullptr);
     CPPA_LOG_TRACE("pptr = " << pptr.get()
                    << ", pptr->node() = " << to_string(pptr->node()));
-    if (pptr->erase_on_last_proxy_exited() && pptr->queue().empty()) {
+    if (   pptr->erase_on_last_proxy_exited()
+        && pptr->queue().empty()
+        && !pptr->has_buffered_data()) {
         stop_reader(pptr.get());
         auto i = m_peers.find(pptr->node());
         if (i != m_peers.end()) {
@@ -241,6 +256,37 @@ void default_protocol::continue_writer(const default_peer_ptr& pptr) {
     super::continue_writer(pptr.get());
 }
 
+void default_protocol::run_delayed(std::chrono::microseconds delay,
+                                   std::function<void()> fun) {
+    super::run_delayed(delay, move(fun));
+}
+
+void default_protocol::set_coalescing_policy(const coalescing_policy& policy) {
+    default_protocol_ptr proto = this;
+    run_later([proto, policy] {
+        CPPA_LOGF_TRACE("lambda from default_protocol::set_coalescing_policy");
+        proto->m_coalescing = policy;
+    });
+}
+
+void default_protocol::flush(const actor_ptr& whom) {
+    CPPA_LOG_TRACE(CPPA_MARG(whom, get));
+    if (!whom || !whom->is_proxy()) return;
+    auto dptr = whom.downcast<default_actor_proxy>();
+    if (!dptr) return;
+    // messages sent via the proxy are enqueued using run_later as well,
+    // i.e., they are already in the peer's buffer when the functor runs
+    auto node = dptr->process_info();
+    default_protocol_ptr proto = this;
+    run_later([proto, node] {
+        CPPA_LOGF_TRACE("lambda from default_protocol::flush");
+        auto i = proto->m_peers.find(*node);
+        if (i != proto->m_peers.end() && i->second.impl) {
+            i->second.impl->flush();
+        }
+    });
+}
+
 default_actor_addressing* default_protocol::addressing() {
     return &m_addressing;
 }
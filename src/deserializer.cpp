@@ -41,6 +41,42 @@ deserializer::deserializer(actor_addressing* aa) : m_addressing(aa) { }
 
 deserializer::~deserializer() { }
 
+namespace {
+
+struct raw_array_reader {
+    deserializer* source;
+    primitive_type ptype;
+    size_t num;
+    void* storage;
+    template<typename T>
+    void operator()(T&) const {
+        auto first = reinterpret_cast<T*>(storage);
+        for (auto last = first + num; first != last; ++first) {
+            auto val = source->read_value(ptype);
+            *first = std::move(get_ref<T>(val));
+        }
+    }
+};
+
+} // namespace <anonymous>
+
+void deserializer::read_raw_array(primitive_type ptype,
+                                  size_t num,
+                                  void* storage) {
+    // the default value of ptype selects the element type
+    primitive_variant token(ptype);
+    token.apply(raw_array_reader{this, ptype, num, storage});
+}
+
+void deserializer::read_members(size_t num,
+                                const primitive_type* ptypes,
+                                void* const* storage) {
+    for (size_t i = 0; i < num; ++i) {
+        primitive_variant token(ptypes[i]);
+        token.apply(raw_array_reader{this, ptypes[i], 1, storage[i]});
+    }
+}
+
 deserializer& operator>>(deserializer& d, object& what) {
     std::string tname = d.peek_object();
     auto mtype = uniform_type_info::from(tname);
@@ -38,7 +38,7 @@ namespace cppa { namespace util {
 
 fiber::fiber() : m_impl(nullptr) { }
 
-fiber::fiber(void (*)(void*), void*) : m_impl(nullptr) { }
+fiber::fiber(void (*)(void*), void*, size_t) : m_impl(nullptr) { }
 
 fiber::~fiber() { }
 
@@ -51,10 +51,210 @@ void fiber::swap(fiber&, fiber&) {
 
 #else // ifdef CPPA_DISABLE_CONTEXT_SWITCHING
 
-#include <boost/context/all.hpp>
+#include <new>
+#include <vector>
+
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+
+#include <boost/version.hpp>
+
+#if BOOST_VERSION >= 106100
+#   include <boost/context/detail/fcontext.hpp>
+#else
+#   include <boost/context/all.hpp>
+#endif
+
+// default stack size of a fiber in bytes
+#ifndef CPPA_FIBER_STACK_SIZE
+#define CPPA_FIBER_STACK_SIZE 65536
+#endif
+
+// maximum number of unused stacks each thread keeps per size class
+#ifndef CPPA_FIBER_STACK_CACHE_SIZE
+#define CPPA_FIBER_STACK_CACHE_SIZE 16
+#endif
 
 namespace cppa { namespace util {
 
+namespace {
+
+inline size_t page_size() {
+    static const size_t result = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return result;
+}
+
+// rounds stack_size up to the next power of two (at least one page)
+size_t stack_size_class(size_t stack_size) {
+    if (stack_size == 0) stack_size = CPPA_FIBER_STACK_SIZE;
+    size_t result = page_size();
+    while (result < stack_size) result <<= 1;
+    return result;
+}
+
+// caches the stacks of destroyed fibers to make spawning
+// context-switching actors allocation-free in steady state;
+// each stack is mapped with a guard page below its lowest address
+class stack_cache {
+
+    struct size_class {
+        size_t stack_size;
+        std::vector<void*> stacks;
+    };
+
+ public:
+
+    ~stack_cache() {
+        for (auto& sc : m_classes) {
+            for (auto sp : sc.stacks) unmap_stack(sp, sc.stack_size);
+        }
+    }
+
+    // returns the top of a stack, i.e., stacks grow downwards from sp
+    void* allocate(size_t stack_size) {
+        auto& stacks = get(stack_size).stacks;
+        if (stacks.empty()) return map_stack(stack_size);
+        auto result = stacks.back();
+        stacks.pop_back();
+        return result;
+    }
+
+    void deallocate(void* sp, size_t stack_size) {
+        auto& stacks = get(stack_size).stacks;
+        if (stacks.size() >= CPPA_FIBER_STACK_CACHE_SIZE) {
+            unmap_stack(sp, stack_size);
+        }
+        else {
+            release_pages(sp, stack_size);
+            stacks.push_back(sp);
+        }
+    }
+
+ private:
+
+    size_class& get(size_t stack_size) {
+        for (auto& sc : m_classes) {
+            if (sc.stack_size == stack_size) return sc;
+        }
+        m_classes.push_back(size_class{stack_size, std::vector<void*>{}});
+        return m_classes.back();
+    }
+
+    static void* map_stack(size_t stack_size) {
+        auto guard = page_size();
+        auto base = mmap(nullptr, stack_size + guard, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (base == MAP_FAILED) throw std::bad_alloc();
+        mprotect(base, guard, PROT_NONE);
+        return static_cast<char*>(base) + guard + stack_size;
+    }
+
+    static void unmap_stack(void* sp, size_t stack_size) {
+        auto guard = page_size();
+        munmap(static_cast<char*>(sp) - stack_size - guard, stack_size + guard);
+    }
+
+    // returns all pages except the topmost one to the OS
+    // but keeps the mapping (including its guard page) alive
+    static void release_pages(void* sp, size_t stack_size) {
+        auto last = static_cast<char*>(sp) - page_size();
+        auto first = static_cast<char*>(sp) - stack_size;
+        if (last > first) {
+#           ifdef MADV_FREE
+            madvise(first, static_cast<size_t>(last - first), MADV_FREE);
+#           else
+            madvise(first, static_cast<size_t>(last - first), MADV_DONTNEED);
+#           endif
+        }
+    }
+
+    std::vector<size_class> m_classes;
+
+};
+
+// the cache lives in a plain thread-local pointer, the pthread key
+// is only used to destroy the cache on thread exit
+__thread stack_cache* t_stack_cache = nullptr;
+
+pthread_key_t s_stack_cache_key;
+pthread_once_t s_stack_cache_key_once = PTHREAD_ONCE_INIT;
+
+void stack_cache_destructor(void* ptr) {
+    t_stack_cache = nullptr;
+    if (ptr) delete reinterpret_cast<stack_cache*>(ptr);
+}
+
+void make_stack_cache_key() {
+    pthread_key_create(&s_stack_cache_key, stack_cache_destructor);
+}
+
+inline stack_cache& get_stack_cache() {
+    auto cache = t_stack_cache;
+    if (!cache) {
+        cache = new stack_cache;
+        pthread_once(&s_stack_cache_key_once, make_stack_cache_key);
+        pthread_setspecific(s_stack_cache_key, cache);
+        t_stack_cache = cache;
+    }
+    return *cache;
+}
+
+} // namespace <anonymous>
+
+#if BOOST_VERSION >= 106100
+
+namespace ctx = boost::context::detail;
+
+class fiber_impl;
+
+// passed from the suspended to the resumed fiber
+struct fiber_switch {
+    fiber_impl* from;
+    fiber_impl* to;
+};
+
+void fiber_trampoline(ctx::transfer_t t);
+
+class fiber_impl {
+
+ public:
+
+    fiber_impl() : m_ctx(nullptr) { }
+
+    virtual ~fiber_impl() { }
+
+    virtual void run() { }
+
+    void swap(fiber_impl* to) {
+        fiber_switch fs{this, to};
+        resumed(ctx::jump_fcontext(to->m_ctx, &fs));
+    }
+
+    // stores the context of the fiber that jumped to the calling fiber
+    static inline fiber_impl* resumed(ctx::transfer_t t) {
+        auto fs = reinterpret_cast<fiber_switch*>(t.data);
+        fs->from->m_ctx = t.fctx;
+        return fs->to;
+    }
+
+ protected:
+
+    // the context is set whenever this fiber gets suspended,
+    // i.e., a converted thread does not need one up front
+    ctx::fcontext_t m_ctx;
+
+};
+
+// a fiber representing a thread ('converts' the thread to a fiber)
+class converted_fiber : public fiber_impl { };
+
+void fiber_trampoline(ctx::transfer_t t) {
+    fiber_impl::resumed(t)->run();
+}
+
+#else // BOOST_VERSION >= 106100
+
 void fiber_trampoline(intptr_t iptr);
 
 namespace ctx = boost::context;
@@ -92,44 +292,47 @@ class converted_fiber : public fiber_impl {
 
 };
 
+void fiber_trampoline(intptr_t iptr) {
+    auto ptr = (fiber_impl*) iptr;
+    ptr->run();
+}
+
+#endif // BOOST_VERSION >= 106100
+
 // a fiber executing a function
 class fun_fiber : public fiber_impl {
 
-    typedef ctx::guarded_stack_allocator allocator;
-
  public:
 
-    fun_fiber(void (*fun)(void*), void* arg) : m_arg(arg), m_fun(fun) {
-        m_size = allocator::minimum_stacksize();
-        m_ctx = ctx::make_fcontext(m_alloc.allocate(m_size), m_size, fiber_trampoline);
+    fun_fiber(void (*fun)(void*), void* arg, size_t stack_size)
+    : m_arg(arg), m_fun(fun), m_size(stack_size_class(stack_size)) {
+        m_stack = get_stack_cache().allocate(m_size);
+        m_ctx = ctx::make_fcontext(m_stack, m_size, fiber_trampoline);
     }
 
     ~fun_fiber() {
-        m_alloc.deallocate(m_ctx->fc_stack.sp, m_size);
+        // the fiber might get destroyed by another thread than
+        // the one that created it, i.e., stacks migrate between caches
+        get_stack_cache().deallocate(m_stack, m_size);
     }
 
     virtual void run() {
         m_fun(m_arg);
     }
 
-
  private:
 
     void* m_arg;
     void (*m_fun)(void*);
     size_t m_size;
-    allocator m_alloc;
+    void* m_stack;
 
 };
 
-void fiber_trampoline(intptr_t iptr) {
-    auto ptr = (fiber_impl*) iptr;
-    ptr->run();
-}
-
 fiber::fiber() : m_impl(new converted_fiber) { }
 
-fiber::fiber(void (*f)(void*), void* arg) : m_impl(new fun_fiber(f, arg)) { }
+fiber::fiber(void (*f)(void*), void* arg, size_t stack_size)
+: m_impl(new fun_fiber(f, arg, stack_size)) { }
 
 void fiber::swap(fiber& from, fiber& to) {
     from.m_impl->swap(to.m_impl);
@@ -40,20 +40,24 @@ class down_observer : public attachable {
 
     actor_ptr m_observer;
     actor_ptr m_observed;
+    // the observer as seen by local_actor::demonitor
+    const void* m_token_ptr;
 
  public:
 
-    down_observer(actor_ptr observer, actor_ptr observed)
-    : m_observer(std::move(observer)), m_observed(std::move(observed)) {
+    down_observer(local_actor* observer, actor_ptr observed)
+    : m_observer(observer), m_observed(std::move(observed))
+    , m_token_ptr(observer) {
         CPPA_REQUIRE(m_observer != nullptr);
         CPPA_REQUIRE(m_observed != nullptr);
     }
 
     void actor_exited(std::uint32_t reason) {
-        if (m_observer) {
-            m_observer->enqueue(m_observed.get(),
-                                make_any_tuple(atom("DOWN"), reason));
-        }
+        actor_exited(reason, make_any_tuple(atom("DOWN"), reason));
+    }
+
+    void actor_exited(std::uint32_t, const any_tuple& down_msg) {
+        if (m_observer) m_observer->enqueue(m_observed.get(), down_msg);
     }
 
     bool matches(const attachable::token& match_token) {
@@ -64,14 +68,26 @@ class down_observer : public attachable {
         return false;
     }
 
+    const void* token_ptr() const {
+        return m_token_ptr;
+    }
+
 };
 
+void forward_node(actor_ptr whom,
+                  detail::recursive_queue_node* node,
+                  message_id_t id,
+                  any_tuple msg) {
+    if (id.valid()) whom->sync_enqueue(node->sender.get(), id, std::move(msg));
+    else whom->enqueue(node->sender.get(), std::move(msg));
+}
+
 } // namespace <anonymous>
 
 local_actor::local_actor(bool sflag)
 : m_chaining(sflag), m_trap_exit(false)
 , m_is_scheduled(sflag), m_dummy_node(), m_current_node(&m_dummy_node)
-, outer_memory(nullptr) { }
+, m_forward_node(nullptr), outer_memory(nullptr) { }
 
 void local_actor::monitor(actor_ptr whom) {
     if (whom) whom->attach(new down_observer(this, whom));
@@ -114,6 +130,7 @@ void local_actor::reply_message(any_tuple&& what) {
         send_message(whom.get(), std::move(what));
     }
     else if (!id.is_answered()) {
+        flush_pending_forward();
         if (chaining_enabled()) {
             if (whom->chained_sync_enqueue(this, id.response_id(), std::move(what))) {
                 m_chained_actor = whom;
@@ -130,16 +147,41 @@ void local_actor::forward_message(const actor_ptr& new_receiver) {
     if (new_receiver == nullptr) {
         return;
     }
-    auto& from = last_sender();
+    // a forward is still pending if a callback forwards its message twice
+    // or if a nested receive forwards another message
+    flush_pending_forward();
     auto id = m_current_node->mid;
-    if (id.valid() == false || id.is_response()) {
-        new_receiver->enqueue(from.get(), m_current_node->msg);
-    }
-    else {
-        new_receiver->sync_enqueue(from.get(), id, m_current_node->msg);
+    auto fwd_id = (id.valid() && !id.is_response()) ? id : message_id_t();
+    if (fwd_id.valid()) {
         // treat this message as asynchronous message from now on
         m_current_node->mid = message_id_t();
     }
+    if (m_current_node == &m_dummy_node) {
+        forward_node(new_receiver, m_current_node, fwd_id, any_tuple{});
+    }
+    else {
+        // the callback still has access to the message; it is moved
+        // to its new receiver by flush_forward() once the callback returned
+        m_forward_node = m_current_node;
+        m_forward_receiver = new_receiver;
+        m_forward_id = fwd_id;
+    }
+}
+
+void local_actor::send_pending_forward() {
+    CPPA_REQUIRE(m_forward_node != nullptr);
+    auto pending = m_forward_node;
+    m_forward_node = nullptr;
+    forward_node(std::move(m_forward_receiver), pending,
+                 m_forward_id, pending->msg);
+}
+
+void local_actor::flush_forward(detail::recursive_queue_node* node) {
+    if (node != nullptr && node == m_forward_node) {
+        m_forward_node = nullptr;
+        forward_node(std::move(m_forward_receiver), node,
+                     m_forward_id, std::move(node->msg));
+    }
 }
 
 sync_recv_helper local_actor::handle_response(const message_future& handle) {
@@ -28,10 +28,17 @@
 \******************************************************************************/
 
 
+#include <mutex>
+#include <atomic>
 #include <vector>
+#include <algorithm>
 #include <typeinfo>
+#include <pthread.h>
+
+#include "cppa/util/shared_spinlock.hpp"
 
 #include "cppa/detail/memory.hpp"
+#include "cppa/detail/pooled_memory.hpp"
 #include "cppa/detail/recursive_queue_node.hpp"
 
 using namespace std;
@@ -84,6 +91,180 @@ void memory::add_cache_map_entry(const type_info* tinf, memory_cache* instance)
 
 instance_wrapper::~instance_wrapper() { }
 
+namespace {
+
+constexpr size_t s_granularity = 16;
+
+constexpr size_t s_num_size_classes = pooled_memory::max_block_size
+                                      / s_granularity;
+
+// number of blocks moved between thread cache and central list at once
+constexpr size_t s_batch_size = 32;
+
+// max. number of cached blocks per size class and thread
+constexpr size_t s_thread_cache_limit = 2 * s_batch_size;
+
+// max. number of cached blocks per size class in the central list
+constexpr size_t s_central_cache_limit = 64 * s_batch_size;
+
+std::atomic<size_t> s_system_allocations;
+std::atomic<size_t> s_system_deallocations;
+std::atomic<size_t> s_central_transfers;
+
+struct free_block {
+    free_block* next;
+};
+
+struct free_list {
+
+    free_block* head;
+    size_t size;
+
+    free_list() : head(nullptr), size(0) { }
+
+    inline void push(void* vptr) {
+        auto ptr = reinterpret_cast<free_block*>(vptr);
+        ptr->next = head;
+        head = ptr;
+        ++size;
+    }
+
+    inline void* pop() {
+        auto result = head;
+        head = result->next;
+        --size;
+        return result;
+    }
+
+    // moves up to n blocks from this list to other
+    void move_to(free_list& other, size_t n) {
+        for (; n > 0 && head != nullptr; --n) other.push(pop());
+    }
+
+    void release_all() {
+        auto n = size;
+        while (head != nullptr) ::operator delete(pop());
+        s_system_deallocations.fetch_add(n, std::memory_order_relaxed);
+    }
+
+};
+
+struct central_list {
+    util::shared_spinlock mtx;
+    free_list blocks;
+};
+
+// never destroyed, because thread caches can flush into it at any time
+central_list* central_lists() {
+    static central_list* result = new central_list[s_num_size_classes];
+    return result;
+}
+
+struct thread_cache {
+
+    free_list lists[s_num_size_classes];
+
+    ~thread_cache() {
+        for (size_t i = 0; i < s_num_size_classes; ++i) {
+            flush(i, lists[i].size);
+        }
+    }
+
+    // moves n blocks of size class i to the central list
+    void flush(size_t i, size_t n) {
+        if (n == 0) return;
+        free_list surplus;
+        auto& central = central_lists()[i];
+        { // lifetime scope of guard
+            std::lock_guard<util::shared_spinlock> guard(central.mtx);
+            auto space = s_central_cache_limit - central.blocks.size;
+            lists[i].move_to(central.blocks, std::min(n, space));
+        }
+        lists[i].move_to(surplus, n);
+        surplus.release_all();
+        s_central_transfers.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // fetches a batch of blocks of size class i from the central list
+    void refill(size_t i) {
+        auto& central = central_lists()[i];
+        std::lock_guard<util::shared_spinlock> guard(central.mtx);
+        if (central.blocks.size > 0) {
+            central.blocks.move_to(lists[i], s_batch_size);
+            s_central_transfers.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+};
+
+// the cache lives in a plain thread-local pointer, the pthread key
+// is only used to destroy the cache on thread exit
+__thread thread_cache* t_thread_cache = nullptr;
+
+pthread_key_t s_pool_key;
+pthread_once_t s_pool_key_once = PTHREAD_ONCE_INIT;
+
+void thread_cache_destructor(void* ptr) {
+    t_thread_cache = nullptr;
+    if (ptr) delete reinterpret_cast<thread_cache*>(ptr);
+}
+
+void make_pool_key() {
+    pthread_key_create(&s_pool_key, thread_cache_destructor);
+}
+
+inline thread_cache& get_thread_cache() {
+    auto cache = t_thread_cache;
+    if (!cache) {
+        cache = new thread_cache;
+        pthread_once(&s_pool_key_once, make_pool_key);
+        pthread_setspecific(s_pool_key, cache);
+        t_thread_cache = cache;
+    }
+    return *cache;
+}
+
+} // namespace <anonymous>
+
+void* pooled_memory::allocate(size_t size) {
+    if (size > max_block_size) {
+        s_system_allocations.fetch_add(1, std::memory_order_relaxed);
+        return ::operator new(size);
+    }
+    auto i = (size - 1) / s_granularity;
+    auto& cache = get_thread_cache();
+    auto& blocks = cache.lists[i];
+    if (blocks.size == 0) {
+        cache.refill(i);
+        if (blocks.size == 0) {
+            s_system_allocations.fetch_add(1, std::memory_order_relaxed);
+            return ::operator new((i + 1) * s_granularity);
+        }
+    }
+    return blocks.pop();
+}
+
+void pooled_memory::deallocate(void* ptr, size_t size) {
+    if (ptr == nullptr) return;
+    if (size > max_block_size) {
+        s_system_deallocations.fetch_add(1, std::memory_order_relaxed);
+        ::operator delete(ptr);
+        return;
+    }
+    auto i = (size - 1) / s_granularity;
+    auto& cache = get_thread_cache();
+    cache.lists[i].push(ptr);
+    if (cache.lists[i].size > s_thread_cache_limit) {
+        cache.flush(i, s_batch_size);
+    }
+}
+
+pooled_memory::counters pooled_memory::statistics() {
+    return {s_system_allocations.load(std::memory_order_relaxed),
+            s_system_deallocations.load(std::memory_order_relaxed),
+            s_central_transfers.load(std::memory_order_relaxed)};
+}
+
 //pair<instance_wrapper*,void*> memory::allocate(const type_info* type) {
 //    return get_cache_map_entry(type)->allocate();
 //}
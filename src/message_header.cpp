@@ -34,9 +34,11 @@ namespace cppa { namespace network {
 
 message_header::message_header(const actor_ptr& s,
                                const actor_ptr& r,
-                               message_id_t mid   )
-: sender(s), receiver(r), id(mid) { }
+                               message_id_t mid,
+                               frame_type t       )
+: sender(s), receiver(r), id(mid), type(t) { }
 
-message_header::message_header() : sender(nullptr), receiver(nullptr), id() { }
+message_header::message_header()
+: sender(nullptr), receiver(nullptr), id(), type(user_frame) { }
 
 } } // namespace cppa::network
@@ -142,11 +142,11 @@ class middleman_event_handler : public middleman_event_handler_base<middleman_ev
 
     size_t num_sockets() const { return m_pollset.size(); }
 
-    pair<event_iterator,event_iterator> poll() {
+    pair<event_iterator,event_iterator> poll(int timeout = -1) {
         CPPA_REQUIRE(m_pollset.empty() == false);
         CPPA_REQUIRE(m_pollset.size() == m_meta.size());
         for (;;) {
-            auto presult = ::poll(m_pollset.data(), m_pollset.size(), -1);
+            auto presult = ::poll(m_pollset.data(), m_pollset.size(), timeout);
             CPPA_LOG_DEBUG("poll() on " << num_sockets()
                            << " sockets returned " << presult);
             if (presult < 0) {
@@ -279,12 +279,12 @@ class middleman_event_handler : public middleman_event_handler_base<middleman_ev
 
     size_t num_sockets() const { return m_meta.size(); }
 
-    pair<event_iterator,event_iterator> poll() {
+    pair<event_iterator,event_iterator> poll(int timeout = -1) {
         CPPA_REQUIRE(m_meta.empty() == false);
         for (;;) {
             CPPA_LOG_DEBUG("epoll_wait on " << num_sockets() << " sockets");
             auto presult = epoll_wait(m_epollfd, m_events.data(),
-                                      (int) m_events.size(), -1);
+                                      (int) m_events.size(), timeout);
             CPPA_LOG_DEBUG("epoll_wait returned " << presult);
             if (presult < 0) {
                 // try again unless critical error occured
@@ -563,6 +563,35 @@ void abstract_middleman::stop_reader(const continuable_reader_ptr& ptr) {
     if (i != last) m_readers.erase(i);
 }
 
+void abstract_middleman::run_delayed(chrono::microseconds delay,
+                                     function<void()> fun) {
+    CPPA_LOG_TRACE("delay = " << delay.count() << "us");
+    m_timeouts.insert(make_pair(chrono::steady_clock::now() + delay,
+                                move(fun)));
+}
+
+int abstract_middleman::poll_timeout() const {
+    if (m_timeouts.empty()) return -1;
+    auto now = chrono::steady_clock::now();
+    auto first = m_timeouts.begin()->first;
+    if (first <= now) return 0;
+    // round up to make sure we don't wake up too early
+    auto us = chrono::duration_cast<chrono::microseconds>(first - now).count();
+    return static_cast<int>((us + 999) / 1000);
+}
+
+void abstract_middleman::handle_timeouts(bool run_all) {
+    auto now = chrono::steady_clock::now();
+    while (!m_timeouts.empty()) {
+        auto i = m_timeouts.begin();
+        if (!run_all && i->first > now) return;
+        auto fun = move(i->second);
+        m_timeouts.erase(i);
+        CPPA_LOG_DEBUG("execute delayed functor");
+        fun();
+    }
+}
+
 void middleman_loop(middleman_impl* impl) {
     middleman_event_handler* handler = &impl->m_handler;
     CPPA_LOGF_TRACE("run middleman loop");
@@ -572,7 +601,7 @@ void middleman_loop(middleman_impl* impl) {
     impl->continue_reader(make_counted<middleman_overseer>(impl->m_pipe_read, impl->m_queue));
     handler->update();
     while (!impl->done()) {
-        auto iters = handler->poll();
+        auto iters = handler->poll(impl->poll_timeout());
         for (auto i = iters.first; i != iters.second; ++i) {
             auto mask = i->type();
             switch (mask) {
@@ -617,9 +646,13 @@ void middleman_loop(middleman_impl* impl) {
             }
             i->handled();
         }
+        impl->handle_timeouts();
         handler->update();
     }
-    CPPA_LOGF_DEBUG("event loop done, erase all readers");
+    CPPA_LOGF_DEBUG("event loop done, run pending delayed functors");
+    // delayed functors might register writers, e.g., to flush buffers
+    impl->handle_timeouts(true);
+    CPPA_LOGF_DEBUG("erase all readers");
     // make sure to write everything before shutting down
     for (auto ptr : impl->m_readers) { handler->erase(ptr, event::read); }
     handler->update();
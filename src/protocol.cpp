@@ -72,4 +72,9 @@ void protocol::stop_writer(continuable_reader* ptr) {
     m_parent->stop_writer(ptr);
 }
 
+void protocol::run_delayed(std::chrono::microseconds delay,
+                           std::function<void()> fun) {
+    m_parent->run_delayed(delay, std::move(fun));
+}
+
 } } // namespace cppa::network
@@ -57,6 +57,7 @@ void response_handle::apply(any_tuple msg) const {
     if (valid()) {
         local_actor* sptr = self.unchecked();
         if (sptr && sptr == m_from) {
+            sptr->flush_pending_forward();
             if (sptr->chaining_enabled()) {
                 if (m_to->chained_sync_enqueue(sptr, m_id, move(msg))) {
                     sptr->chained_actor(m_to);
@@ -34,7 +34,8 @@
 namespace cppa {
 
 scheduled_actor::scheduled_actor(bool enable_chained_send)
-: local_actor(enable_chained_send), next(0), m_scheduler(0), m_hidden(false) { }
+: local_actor(enable_chained_send), next(0), m_scheduler(0), m_hidden(false)
+, m_node_affinity(-1) { }
 
 void scheduled_actor::attach_to_scheduler(scheduler* sched, bool hidden) {
     CPPA_REQUIRE(sched != nullptr);
@@ -254,6 +254,14 @@ attachable* scheduler::register_hidden_context() {
     return new exit_observer;
 }
 
+std::vector<actor_ptr> scheduler::spawn_batch(const std::vector<scheduled_actor*>& what,
+                                              scheduling_hint hint) {
+    std::vector<actor_ptr> result;
+    result.reserve(what.size());
+    for (auto ptr : what) result.push_back(spawn(ptr, hint));
+    return result;
+}
+
 void set_scheduler(scheduler* sched) {
     if (detail::singleton_manager::set_scheduler(sched) == false) {
         throw std::runtime_error("scheduler already set");
@@ -264,6 +272,14 @@ void set_default_scheduler(size_t num_threads) {
     set_scheduler(new detail::thread_pool_scheduler(num_threads));
 }
 
+void set_default_scheduler(size_t num_threads,
+                           size_t max_io_threads,
+                           size_t min_io_threads) {
+    set_scheduler(new detail::thread_pool_scheduler(num_threads,
+                                                    max_io_threads,
+                                                    min_io_threads));
+}
+
 scheduler* get_scheduler() {
     return detail::singleton_manager::get_scheduler();
 }
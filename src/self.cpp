@@ -40,6 +40,11 @@ namespace cppa {
 
 namespace {
 
+// the current actor lives in a plain thread-local pointer, the pthread key
+// is only used to get notified on thread exit if a thread owns a reference
+__thread local_actor* t_self = nullptr;
+__thread bool t_key_registered = false;
+
 pthread_key_t s_key;
 pthread_once_t s_key_once = PTHREAD_ONCE_INIT;
 
@@ -50,48 +55,60 @@ local_actor* tss_constructor() {
     return result;
 }
 
-void tss_destructor(void* vptr) {
-    if (vptr) self_type::cleanup_fun(reinterpret_cast<local_actor*>(vptr));
+void tss_destructor(void*) {
+    // thread-local storage is still valid while key destructors run
+    auto ptr = t_self;
+    t_self = nullptr;
+    t_key_registered = false;
+    if (ptr) self_type::cleanup_fun(ptr);
 }
 
 void tss_make_key() {
     pthread_key_create(&s_key, tss_destructor);
 }
 
-local_actor* tss_get() {
-    pthread_once(&s_key_once, tss_make_key);
-    return reinterpret_cast<local_actor*>(pthread_getspecific(s_key));
+// called whenever an owned pointer is stored, does real work once per thread
+inline void tss_register() {
+    if (!t_key_registered) {
+        pthread_once(&s_key_once, tss_make_key);
+        // any non-null value makes sure tss_destructor runs on thread exit
+        pthread_setspecific(s_key, &t_self);
+        t_key_registered = true;
+    }
 }
 
-local_actor* tss_release() {
-    pthread_once(&s_key_once, tss_make_key);
-    auto result = reinterpret_cast<local_actor*>(pthread_getspecific(s_key));
-    if (result) {
-        pthread_setspecific(s_key, nullptr);
-    }
+inline local_actor* tss_get() {
+    return t_self;
+}
+
+inline local_actor* tss_release() {
+    auto result = t_self;
+    t_self = nullptr;
     return result;
 }
 
 local_actor* tss_get_or_create() {
-    pthread_once(&s_key_once, tss_make_key);
-    auto result = reinterpret_cast<local_actor*>(pthread_getspecific(s_key));
+    auto result = t_self;
     if (!result) {
+        // lazily convert threads that are not actors only when needed
         result = tss_constructor();
-        pthread_setspecific(s_key, reinterpret_cast<void*>(result));
+        tss_register();
+        t_self = result;
     }
     return result;
 }
 
 void tss_reset(local_actor* ptr, bool inc_ref_count = true) {
-    pthread_once(&s_key_once, tss_make_key);
-    auto old_ptr = reinterpret_cast<local_actor*>(pthread_getspecific(s_key));
+    auto old_ptr = t_self;
     if (old_ptr) {
-        tss_destructor(old_ptr);
+        t_self = nullptr;
+        self_type::cleanup_fun(old_ptr);
     }
-    if (ptr != nullptr && inc_ref_count) {
-        ptr->ref();
+    if (ptr != nullptr) {
+        if (inc_ref_count) ptr->ref();
+        tss_register();
     }
-    pthread_setspecific(s_key, reinterpret_cast<void*>(ptr));
+    t_self = ptr;
 }
 
 } // namespace <anonymous>
@@ -139,4 +156,11 @@ self_type::pointer self_type::release_impl() {
     return tss_release();
 }
 
+self_type::pointer self_type::swap_impl(self_type::pointer ptr) {
+    // swapped values are borrowed, i.e., no need to register the key
+    auto result = t_self;
+    t_self = ptr;
+    return result;
+}
+
 } // namespace cppa
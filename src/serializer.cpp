@@ -29,11 +29,46 @@
 
 
 #include "cppa/serializer.hpp"
+#include "cppa/primitive_variant.hpp"
 
 namespace cppa {
 
+namespace {
+
+struct raw_array_writer {
+    serializer* sink;
+    size_t num;
+    const void* values;
+    template<typename T>
+    void operator()(const T&) const {
+        auto first = reinterpret_cast<const T*>(values);
+        for (auto last = first + num; first != last; ++first) {
+            sink->write_value(*first);
+        }
+    }
+};
+
+} // namespace <anonymous>
+
 serializer::serializer(actor_addressing* aa) : m_addressing(aa) { }
 
 serializer::~serializer() { }
 
+void serializer::write_raw_array(primitive_type ptype,
+                                 size_t num,
+                                 const void* values) {
+    // the default value of ptype selects the element type
+    primitive_variant token(ptype);
+    token.apply(raw_array_writer{this, num, values});
+}
+
+void serializer::write_members(size_t num,
+                               const primitive_type* ptypes,
+                               const void* const* values) {
+    for (size_t i = 0; i < num; ++i) {
+        primitive_variant token(ptypes[i]);
+        token.apply(raw_array_writer{this, 1, values[i]});
+    }
+}
+
 } // namespace cppa
@@ -28,16 +28,32 @@
 \******************************************************************************/
 
 
+#include <map>
+#include <deque>
 #include <mutex>
+#include <string>
 #include <thread>
+#include <vector>
+#include <chrono>
 #include <cstdint>
 #include <cstddef>
+#include <fstream>
 #include <iostream>
+#include <algorithm>
+#include <functional>
+#include <condition_variable>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <pthread.h>
+#endif
 
 #include "cppa/event_based_actor.hpp"
 #include "cppa/thread_mapped_actor.hpp"
 
 #include "cppa/detail/actor_count.hpp"
+#include "cppa/detail/actor_registry.hpp"
+#include "cppa/detail/singleton_manager.hpp"
 #include "cppa/context_switching_actor.hpp"
 #include "cppa/detail/thread_pool_scheduler.hpp"
 
@@ -51,17 +67,107 @@ namespace {
 typedef std::unique_lock<std::mutex> guard_type;
 typedef intrusive::single_reader_queue<thread_pool_scheduler::worker> worker_queue;
 
+// maximum number of consecutive jobs a worker takes from its next slot
+// or from chained actors before it goes back to the shared job queue
+constexpr size_t max_next_streak = 16;
+
+// the worker running on this thread (if any)
+__thread thread_pool_scheduler::worker* t_worker = nullptr;
+
+// parses a Linux CPU list such as "0-3,8-11"
+std::vector<int> parse_cpu_list(const std::string& str) {
+    std::vector<int> result;
+    size_t pos = 0;
+    while (pos < str.size()) {
+        auto end = str.find(',', pos);
+        if (end == std::string::npos) end = str.size();
+        auto range = str.substr(pos, end - pos);
+        auto dash = range.find('-');
+        try {
+            int first = std::stoi(range.substr(0, dash));
+            int last = (dash == std::string::npos) ? first
+                                                   : std::stoi(range.substr(dash + 1));
+            for (int cpu = first; cpu <= last; ++cpu) result.push_back(cpu);
+        }
+        catch (std::exception&) { /* skip malformed entries */ }
+        pos = end + 1;
+    }
+    return result;
+}
+
+// returns the CPUs of each NUMA node that has CPUs, in ascending order
+// of the node IDs; returns a single node with an empty CPU list
+// if the topology is unknown
+std::vector<std::vector<int> > numa_nodes() {
+    std::vector<std::vector<int> > result;
+#   ifdef __linux__
+    std::map<int, std::vector<int> > nodes;
+    const std::string sysfs = "/sys/devices/system/node/";
+    auto dir = opendir(sysfs.c_str());
+    if (dir) {
+        while (auto entry = readdir(dir)) {
+            std::string name = entry->d_name;
+            if (name.compare(0, 4, "node") != 0 || name.size() == 4) continue;
+            if (name.find_first_not_of("0123456789", 4) != std::string::npos) continue;
+            std::ifstream in(sysfs + name + "/cpulist");
+            std::string line;
+            if (std::getline(in, line)) {
+                auto cpus = parse_cpu_list(line);
+                if (!cpus.empty()) nodes[std::stoi(name.substr(4))] = std::move(cpus);
+            }
+        }
+        closedir(dir);
+    }
+    for (auto& kvp : nodes) result.push_back(std::move(kvp.second));
+#   endif
+    if (result.empty()) result.emplace_back();
+    return result;
+}
+
+// restricts the calling thread to the CPUs in @p cpus
+void pin_to(const std::vector<int>& cpus) {
+#   ifdef __linux__
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    for (int cpu : cpus) CPU_SET(cpu, &cpuset);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+#   else
+    static_cast<void>(cpus);
+#   endif
+}
+
 } // namespace <anonmyous>
 
 struct thread_pool_scheduler::worker {
 
     typedef scheduled_actor* job_ptr;
 
+    thread_pool_scheduler* m_parent;
+    // NUMA node of this worker
+    size_t m_node;
+    // job queue of m_node
     job_queue* m_job_queue;
+    // job queues of all other nodes, used for work stealing
+    std::vector<job_queue*> m_victims;
+    // all other workers of m_node, used for stealing their next slot
+    std::vector<worker*> m_siblings;
     job_ptr m_dummy;
     std::thread m_thread;
-
-    worker(job_queue* jq, job_ptr dummy) : m_job_queue(jq), m_dummy(dummy) { }
+    // actor that became ready while this worker was running a job;
+    // it runs next on this worker to keep request/response pairs
+    // on the same core with hot caches unless an idle worker steals it
+    std::atomic<job_ptr> m_next;
+    size_t m_next_streak;
+
+    worker(thread_pool_scheduler* parent, size_t node, job_ptr dummy)
+    : m_parent(parent), m_node(node), m_dummy(dummy)
+    , m_next(nullptr), m_next_streak(0) {
+        auto& queues = parent->m_queues;
+        m_job_queue = queues[node].get();
+        for (size_t i = 1; i < queues.size(); ++i) {
+            m_victims.push_back(queues[(node + i) % queues.size()].get());
+        }
+    }
 
     void start() {
         m_thread = std::thread(&thread_pool_scheduler::worker_loop, this);
@@ -71,10 +177,40 @@ struct thread_pool_scheduler::worker {
 
     worker& operator=(const worker&) = delete;
 
+    // pops a job from the local queue or steals one from the next
+    // slot of a busy worker or from the queue of another node
+    job_ptr try_pop() {
+        auto result = m_job_queue->try_pop();
+        if (result) {
+            m_next_streak = 0;
+            return result;
+        }
+        for (auto sibling : m_siblings) {
+            // do not write to the cache line of an empty slot
+            if (sibling->m_next.load(std::memory_order_relaxed) != nullptr) {
+                result = sibling->m_next.exchange(nullptr,
+                                                  std::memory_order_acq_rel);
+                if (result) return result;
+            }
+        }
+        for (auto victim : m_victims) {
+            result = victim->try_pop();
+            if (result == m_dummy) {
+                // leave the dummy of doom to workers of that node
+                victim->push_back(result);
+            }
+            else if (result) {
+                m_next_streak = 0;
+                return result;
+            }
+        }
+        return nullptr;
+    }
+
     job_ptr aggressive_polling() {
         job_ptr result = nullptr;
         for (int i = 0; i < 100; ++i) {
-            result = m_job_queue->try_pop();
+            result = try_pop();
             if (result) {
                 return result;
             }
@@ -86,7 +222,7 @@ struct thread_pool_scheduler::worker {
     job_ptr less_aggressive_polling() {
         job_ptr result = nullptr;
         for (int i = 0; i < 550; ++i) {
-            result =  m_job_queue->try_pop();
+            result = try_pop();
             if (result) {
                 return result;
             }
@@ -99,7 +235,7 @@ struct thread_pool_scheduler::worker {
     job_ptr relaxed_polling() {
         job_ptr result = nullptr;
         for (;;) {
-            result =  m_job_queue->try_pop();
+            result = try_pop();
             if (result) {
                 return result;
             }
@@ -107,7 +243,39 @@ struct thread_pool_scheduler::worker {
         }
     }
 
+    // puts @p what into the next slot; a previous occupant
+    // is moved to the shared job queue
+    void set_next(job_ptr what) {
+        auto old = m_next.exchange(what, std::memory_order_acq_rel);
+        if (old) m_job_queue->push_back(old);
+    }
+
+    // returns the job that runs next on this worker, i.e., @p pending
+    // (a chained actor) or the actor in the next slot
+    job_ptr fetch_next(job_ptr pending) {
+        // the slot might have been emptied by another worker
+        auto result = pending ? pending
+                              : m_next.exchange(nullptr,
+                                                std::memory_order_acq_rel);
+        if (result) {
+            if (++m_next_streak > max_next_streak) {
+                // starvation guard: give queued jobs a chance to run
+                m_job_queue->push_back(result);
+                return nullptr;
+            }
+        }
+        return result;
+    }
+
     void operator()() {
+        // pin this worker before it allocates anything, i.e., its memory
+        // caches are placed on its node by the first touch policy;
+        // pinning is pointless on machines with a single NUMA node
+        auto& nodes = m_parent->m_nodes;
+        if (nodes.size() > 1) pin_to(nodes[m_node]);
+        t_worker = this;
+        // workers spawn most actors, i.e., they reserve IDs in blocks
+        singleton_manager::get_actor_registry()->use_id_blocks();
         util::fiber fself;
         job_ptr job = nullptr;
         auto fetch_pending = [&job]() -> job_ptr {
@@ -148,6 +316,7 @@ struct thread_pool_scheduler::worker {
                             job = fetch_pending();
                         }
                     }
+                    job = fetch_next(job);
                 }
                 while (job);
             }
@@ -160,66 +329,219 @@ void thread_pool_scheduler::worker_loop(thread_pool_scheduler::worker* w) {
     (*w)();
 }
 
-thread_pool_scheduler::thread_pool_scheduler() {
+// a pool of threads for actors performing blocking I/O; each job is the
+// entire lifetime of a thread-mapped actor, i.e., a job occupies its
+// thread until the actor is done; a new thread starts whenever a job
+// arrives while all threads are busy, unless the pool already runs
+// m_max_threads threads, in which case the job waits for the next
+// thread that becomes available; idle threads beyond m_min_threads
+// terminate after some time
+struct thread_pool_scheduler::io_pool {
+
+    typedef std::function<void ()> job_type;
+
+    static constexpr std::chrono::seconds max_idle_time{10};
+
+    std::mutex m_mtx;
+    std::condition_variable m_cv;
+    std::deque<job_type> m_jobs;
+    size_t m_max_threads;
+    size_t m_min_threads;
+    // number of threads waiting for a job
+    size_t m_idle;
+    bool m_shutting_down;
+    // running threads
+    std::map<std::thread::id, std::thread> m_threads;
+    // terminated threads that are not joined yet
+    std::vector<std::thread> m_finished;
+
+    io_pool(size_t max_threads, size_t min_threads)
+    : m_max_threads(std::max<size_t>(max_threads, 1))
+    , m_min_threads(min_threads), m_idle(0), m_shutting_down(false) { }
+
+    void run(job_type job) {
+        std::vector<std::thread> finished;
+        { // lifetime scope of guard
+            guard_type guard(m_mtx);
+            m_jobs.push_back(std::move(job));
+            // each pending job needs an idle thread of its own, because
+            // a job might block its thread until the actor is done
+            if (m_jobs.size() > m_idle && m_threads.size() < m_max_threads) {
+                std::thread t([this]() { thread_loop(); });
+                auto id = t.get_id();
+                m_threads.emplace(id, std::move(t));
+            }
+            else m_cv.notify_one();
+            finished.swap(m_finished);
+        }
+        for (auto& t : finished) t.join();
+    }
+
+    // waits until all jobs are done and joins all threads
+    void shutdown() {
+        guard_type guard(m_mtx);
+        m_shutting_down = true;
+        m_cv.notify_all();
+        while (!m_threads.empty()) m_cv.wait(guard);
+        auto finished = std::move(m_finished);
+        guard.unlock();
+        for (auto& t : finished) t.join();
+    }
+
+    void thread_loop() {
+        guard_type guard(m_mtx);
+        for (;;) {
+            while (m_jobs.empty()) {
+                if (m_shutting_down) {
+                    finish();
+                    return;
+                }
+                ++m_idle;
+                auto status = m_cv.wait_for(guard, max_idle_time);
+                --m_idle;
+                if (   status == std::cv_status::timeout
+                    && m_jobs.empty()
+                    && m_threads.size() > m_min_threads) {
+                    finish();
+                    return;
+                }
+            }
+            auto job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+            guard.unlock();
+            job();
+            guard.lock();
+        }
+    }
+
+    // moves the handle of the calling thread to m_finished;
+    // the caller must hold m_mtx
+    void finish() {
+        auto i = m_threads.find(std::this_thread::get_id());
+        m_finished.push_back(std::move(i->second));
+        m_threads.erase(i);
+        // wake up shutdown()
+        if (m_shutting_down) m_cv.notify_all();
+    }
+
+};
+
+constexpr std::chrono::seconds thread_pool_scheduler::io_pool::max_idle_time;
+
+thread_pool_scheduler::thread_pool_scheduler()
+: m_nodes(numa_nodes()), m_next_queue(0)
+, m_io_pool(new io_pool(default_max_io_threads, default_min_io_threads)) {
     m_num_threads = std::max<size_t>(std::thread::hardware_concurrency() * 2, 4);
+    init_queues();
 }
 
-thread_pool_scheduler::thread_pool_scheduler(size_t num_worker_threads) {
+thread_pool_scheduler::thread_pool_scheduler(size_t num_worker_threads,
+                                             size_t max_io_threads,
+                                             size_t min_io_threads)
+: m_nodes(numa_nodes()), m_next_queue(0)
+, m_io_pool(new io_pool(max_io_threads, min_io_threads)) {
     m_num_threads = num_worker_threads;
+    init_queues();
 }
 
+thread_pool_scheduler::~thread_pool_scheduler() { }
 
-void thread_pool_scheduler::supervisor_loop(job_queue* jqueue,
-                                            scheduled_actor* dummy,
-                                            size_t num_threads) {
+void thread_pool_scheduler::init_queues() {
+    for (size_t i = 0; i < m_nodes.size(); ++i) {
+        m_queues.emplace_back(new job_queue);
+    }
+}
+
+void thread_pool_scheduler::supervisor_loop(thread_pool_scheduler* self) {
     std::vector<std::unique_ptr<thread_pool_scheduler::worker> > workers;
-    for (size_t i = 0; i < num_threads; ++i) {
-        workers.emplace_back(new worker(jqueue, dummy));
-        workers.back()->start();
+    auto& nodes = self->m_nodes;
+    for (size_t i = 0; i < self->m_num_threads; ++i) {
+        auto node = i % nodes.size();
+        workers.emplace_back(new worker(self, node, &self->m_dummy));
+    }
+    for (auto& w : workers) {
+        for (auto& other : workers) {
+            if (other != w && other->m_node == w->m_node) {
+                w->m_siblings.push_back(other.get());
+            }
+        }
     }
+    for (auto& w : workers) w->start();
     // wait for workers
     for (auto& w : workers) {
         w->m_thread.join();
     }
+    // move actors left in next slots to the job queues,
+    // where destroy() releases them
+    for (auto& w : workers) {
+        auto job = w->m_next.exchange(nullptr, std::memory_order_acq_rel);
+        if (job) w->m_job_queue->push_back(job);
+    }
 }
 
 void thread_pool_scheduler::initialize() {
-    m_supervisor = std::thread(&thread_pool_scheduler::supervisor_loop,
-                               &m_queue, &m_dummy, m_num_threads);
+    m_supervisor = std::thread(&thread_pool_scheduler::supervisor_loop, this);
     super::initialize();
 }
 
 void thread_pool_scheduler::destroy() {
-    m_queue.push_back(&m_dummy);
+    for (auto& q : m_queues) q->push_back(&m_dummy);
     m_supervisor.join();
-    // make sure job queue is empty, because destructor of m_queue would
+    // waits for all actors spawned with the blocking_io hint
+    m_io_pool->shutdown();
+    // make sure job queues are empty, because destructor of job_queue would
     // otherwise delete elements it shouldn't
-    auto ptr = m_queue.try_pop();
-    while (ptr != nullptr) {
-        if (ptr != &m_dummy) {
-            bool hidden = ptr->is_hidden();
-            ptr->deref();
-            std::atomic_thread_fence(std::memory_order_seq_cst);
-            if (!hidden) dec_actor_count();
+    for (auto& q : m_queues) {
+        auto ptr = q->try_pop();
+        while (ptr != nullptr) {
+            if (ptr != &m_dummy) {
+                bool hidden = ptr->is_hidden();
+                ptr->deref();
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (!hidden) dec_actor_count();
+            }
+            ptr = q->try_pop();
         }
-        ptr = m_queue.try_pop();
     }
     super::destroy();
 }
 
 void thread_pool_scheduler::enqueue(scheduled_actor* what) {
-    m_queue.push_back(what);
+    // actors woken up by a job of one of our workers run next on that
+    // worker unless they prefer another NUMA node
+    auto w = t_worker;
+    if (w != nullptr && w->m_parent == this) {
+        auto node = what->node_affinity();
+        if (node < 0 || static_cast<size_t>(node) == w->m_node) {
+            w->set_next(what);
+            return;
+        }
+    }
+    push_job(what);
+}
+
+void thread_pool_scheduler::push_job(scheduled_actor* what) {
+    auto node = what->node_affinity();
+    size_t i;
+    if (node >= 0) i = static_cast<size_t>(node) % m_queues.size();
+    else if (t_worker != nullptr && t_worker->m_parent == this) {
+        i = t_worker->m_node;
+    }
+    else i = m_next_queue.fetch_add(1, std::memory_order_relaxed)
+             % m_queues.size();
+    m_queues[i]->push_back(what);
 }
 
 actor_ptr thread_pool_scheduler::spawn_as_thread(void_function fun,
                                                  init_callback cb,
-                                                 bool hidden) {
+                                                 bool hidden,
+                                                 bool blocking_io) {
     if (!hidden) inc_actor_count();
     thread_mapped_actor_ptr ptr{new thread_mapped_actor(std::move(fun))};
     ptr->init();
     ptr->initialized(true);
     cb(ptr.get());
-    std::thread([hidden, ptr]() {
+    auto job = [hidden, ptr]() {
         scoped_self_setter sss{ptr.get()};
         try {
             ptr->run();
@@ -228,7 +550,9 @@ actor_ptr thread_pool_scheduler::spawn_as_thread(void_function fun,
         catch (...) { }
         std::atomic_thread_fence(std::memory_order_seq_cst);
         if (!hidden) dec_actor_count();
-    }).detach();
+    };
+    if (blocking_io) m_io_pool->run(std::move(job));
+    else std::thread(std::move(job)).detach();
     return ptr;
 }
 
@@ -238,7 +562,7 @@ actor_ptr thread_pool_scheduler::spawn_impl(scheduled_actor_ptr what) {
         what->ref();
         // event-based actors are not pushed to the job queue on startup
         if (what->impl_type() == context_switching_impl) {
-            m_queue.push_back(what.get());
+            push_job(what.get());
         }
     }
     else {
@@ -263,6 +587,35 @@ actor_ptr thread_pool_scheduler::spawn(scheduled_actor* raw,
     return spawn_impl(std::move(ptr));
 }
 
+std::vector<actor_ptr>
+thread_pool_scheduler::spawn_batch(const std::vector<scheduled_actor*>& what,
+                                   scheduling_hint hint) {
+    bool hidden = hint == scheduled_and_hidden;
+    std::vector<actor_ptr> result;
+    std::vector<scheduled_actor*> jobs;
+    result.reserve(what.size());
+    size_t running = 0;
+    for (auto raw : what) {
+        scheduled_actor_ptr ptr{raw};
+        ptr->attach_to_scheduler(this, hidden);
+        if (ptr->has_behavior()) {
+            ++running;
+            ptr->ref();
+            if (ptr->impl_type() == context_switching_impl) {
+                jobs.push_back(ptr.get());
+            }
+        }
+        else {
+            ptr->on_exit();
+        }
+        result.push_back(std::move(ptr));
+    }
+    // update the shared actor count only once per batch
+    if (!hidden && running > 0) inc_actor_count(running);
+    for (auto job : jobs) push_job(job);
+    return result;
+}
+
 #ifndef CPPA_DISABLE_CONTEXT_SWITCHING
 
 actor_ptr thread_pool_scheduler::spawn(void_function fun, scheduling_hint hint) {
@@ -274,7 +627,8 @@ actor_ptr thread_pool_scheduler::spawn(void_function fun, scheduling_hint hint)
     else {
         return spawn_as_thread(std::move(fun),
                                [](local_actor*) { },
-                               hint == detached_and_hidden);
+                               hint == detached_and_hidden,
+                               hint == blocking_io);
     }
 }
 actor_ptr thread_pool_scheduler::spawn(void_function fun,
@@ -289,7 +643,8 @@ actor_ptr thread_pool_scheduler::spawn(void_function fun,
     else {
         return spawn_as_thread(std::move(fun),
                                std::move(init_cb),
-                               hint == detached_and_hidden);
+                               hint == detached_and_hidden,
+                               hint == blocking_io);
     }
 }
 
@@ -298,7 +653,8 @@ actor_ptr thread_pool_scheduler::spawn(void_function fun,
 actor_ptr thread_pool_scheduler::spawn(void_function what, scheduling_hint sh) {
     return spawn_as_thread(std::move(what),
                            [](local_actor*) { },
-                           sh == detached_and_hidden);
+                           sh == detached_and_hidden,
+                           sh == blocking_io);
 }
 
 actor_ptr thread_pool_scheduler::spawn(void_function what,
@@ -306,7 +662,8 @@ actor_ptr thread_pool_scheduler::spawn(void_function what,
                                        scheduling_hint sh) {
     return spawn_as_thread(std::move(what),
                            std::move(init_cb),
-                           sh == detached_and_hidden);
+                           sh == detached_and_hidden,
+                           sh == blocking_io);
 }
 #endif
 
@@ -52,6 +52,7 @@
 #include "cppa/network/middleman.hpp"
 #include "cppa/network/ipv4_acceptor.hpp"
 #include "cppa/network/ipv4_io_stream.hpp"
+#include "cppa/network/default_protocol.hpp"
 
 #include "cppa/detail/actor_registry.hpp"
 #include "cppa/detail/singleton_manager.hpp"
@@ -84,4 +85,14 @@ actor_ptr remote_actor(const char* host, std::uint16_t port) {
     return proto()->remote_actor({port, host});
 }
 
+void set_coalescing_policy(const coalescing_policy& policy) {
+    auto dproto = dynamic_cast<default_protocol*>(proto());
+    if (dproto) dproto->set_coalescing_policy(policy);
+}
+
+void flush_remote(const actor_ptr& whom) {
+    auto dproto = dynamic_cast<default_protocol*>(proto());
+    if (dproto) dproto->flush(whom);
+}
+
 } // namespace cppa
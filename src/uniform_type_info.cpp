@@ -32,9 +32,12 @@
 
 #include <map>
 #include <set>
+#include <mutex>
+#include <vector>
 #include <locale>
 #include <string>
 #include <atomic>
+#include <algorithm>
 #include <limits>
 #include <cstring>
 #include <cstdint>
@@ -53,6 +56,7 @@
 
 #include "cppa/util/duration.hpp"
 #include "cppa/util/void_type.hpp"
+#include "cppa/util/shared_lock_guard.hpp"
 
 #include "cppa/detail/demangle.hpp"
 #include "cppa/detail/object_array.hpp"
@@ -362,17 +366,33 @@ class any_tuple_tinfo : public util::abstract_uniform_type_info<any_tuple> {
                               deserializer* source,
                               const string& name) {
         uniform_type_info::assert_type_name(source, name);
-        auto result = new detail::object_array;
         source->begin_object(name);
         size_t tuple_size = source->begin_sequence();
+        vector<object> elements;
+        uniform_type_info_map::signature_type signature;
+        elements.reserve(tuple_size);
+        signature.reserve(tuple_size);
         for (size_t i = 0; i < tuple_size; ++i) {
             auto tname = source->peek_object();
             auto utype = uniform_type_info::from(tname);
-            result->push_back(utype->deserialize(source));
+            elements.push_back(utype->deserialize(source));
+            signature.push_back(utype);
         }
         source->end_sequence();
         source->end_object();
-        atref = any_tuple{result};
+        // create a statically typed tuple if the signature is known,
+        // because this enables the fast path of the pattern matching
+        auto factory = uti_map().signature_factory(signature);
+        if (factory) {
+            atref = any_tuple{factory(elements)};
+        }
+        else {
+            auto result = new detail::object_array;
+            for (auto& element : elements) {
+                result->push_back(std::move(element));
+            }
+            atref = any_tuple{result};
+        }
     }
 
  protected:
@@ -401,6 +421,7 @@ class msg_hdr_tinfo : public util::abstract_uniform_type_info<network::message_h
         actor_ptr_tinfo::s_serialize(hdr.sender, sink, actor_ptr_name);
         actor_ptr_tinfo::s_serialize(hdr.receiver, sink, actor_ptr_name);
         sink->write_value(hdr.id.integer_value());
+        sink->write_value(static_cast<std::uint8_t>(hdr.type));
         sink->end_object();
     }
 
@@ -413,6 +434,11 @@ class msg_hdr_tinfo : public util::abstract_uniform_type_info<network::message_h
         actor_ptr_tinfo::s_deserialize(msg.receiver, source, actor_ptr_name);
         auto msg_id = source->read<std::uint64_t>();
         msg.id = message_id_t::from_integer_value(msg_id);
+        auto type = source->read<std::uint8_t>();
+        if (type > network::message_header::control_frame) {
+            throw std::runtime_error("invalid frame type in message header");
+        }
+        msg.type = static_cast<network::message_header::frame_type>(type);
         source->end_object();
     }
 
@@ -529,13 +555,7 @@ class int_tinfo : public detail::default_uniform_type_info_impl<T> {
  public:
 
     bool equals(const type_info& tinfo) const {
-        // TODO: string comparsion sucks & is slow; find a nicer solution
-        auto map_iter = uti_map().int_names().find(sizeof(T));
-        const string_set& st = is_signed<T>::value ? map_iter->second.first
-                                                   : map_iter->second.second;
-        auto x = raw_name(tinfo);
-        return any_of(st.begin(), st.end(),
-                           [&x](const string& y) { return x == y; });
+        return uti_map().by_type_info(tinfo) == this;
     }
 
 };
@@ -587,7 +607,38 @@ class uniform_type_info_map_helper {
 
 };
 
-uniform_type_info_map::uniform_type_info_map() {
+// throws if the type ID of a built-in type differs from its
+// index in builtin_types, since uniform_typeid<T>() relies on it
+template<class List>
+struct check_builtin_ids;
+
+template<>
+struct check_builtin_ids<util::empty_type_list> {
+    static inline void _(const uniform_type_info_map*) { }
+};
+
+template<typename T, typename... Ts>
+struct check_builtin_ids<util::type_list<T, Ts...>> {
+    static void _(const uniform_type_info_map* umap) {
+        auto expected = static_cast<std::uint32_t>(builtin_type_id<T>::value);
+        auto uti = umap->by_raw_name(raw_name<T>());
+        if (uti == nullptr || uti->id() != expected) {
+            std::string error_str = raw_name<T>();
+            error_str += " has not the type ID defined by builtin_types";
+            throw std::logic_error(error_str);
+        }
+        check_builtin_ids<util::type_list<Ts...>>::_(umap);
+    }
+};
+
+uniform_type_info_map::uniform_type_info_map() : m_next_id(0) {
+    for (auto& chunk : m_by_id) {
+        chunk.store(nullptr, std::memory_order_relaxed);
+    }
+    for (auto& slot : m_by_tinfo) {
+        slot.key.store(nullptr, std::memory_order_relaxed);
+        slot.value.store(nullptr, std::memory_order_relaxed);
+    }
     // inserts all compiler generated raw-names to m_ings
     push<char,                  signed char,
          unsigned char,         short,
@@ -637,6 +688,10 @@ uniform_type_info_map::uniform_type_info_map() {
     insert({raw_name<util::void_type>()}, new void_type_tinfo);
     insert({raw_name<process_information_ptr>()}, new process_info_ptr_tinfo);
     insert({raw_name<map<string,string>>()}, new default_uniform_type_info_impl<map<string,string>>);
+    insert({raw_name<vector<uint32_t>>()}, new default_uniform_type_info_impl<vector<uint32_t>>);
+    // the order above has to match the type IDs defined by builtin_types
+    check_builtin_ids<builtin_types>::_(this);
+    CPPA_REQUIRE(m_next_id == builtin_types::size);
 }
 
 uniform_type_info_map::~uniform_type_info_map() {
@@ -646,6 +701,9 @@ uniform_type_info_map::~uniform_type_info_map() {
         kvp.second = nullptr;
     }
     m_by_uname.clear();
+    for (auto& chunk : m_by_id) {
+        delete[] chunk.load();
+    }
 }
 
 const uniform_type_info* uniform_type_info_map::by_raw_name(const std::string& name) const {
@@ -658,13 +716,58 @@ const uniform_type_info* uniform_type_info_map::by_uniform_name(const std::strin
     return (i != m_by_uname.end()) ? i->second : nullptr;
 }
 
+const uniform_type_info* uniform_type_info_map::by_type_info(const std::type_info& tinfo) const {
+    static constexpr size_t max_probes = 8;
+    auto key = &tinfo;
+    auto hash = static_cast<size_t>(reinterpret_cast<std::uintptr_t>(key) >> 4);
+    for (size_t i = 0; i < max_probes; ++i) {
+        auto& slot = m_by_tinfo[(hash + i) % tinfo_cache_size];
+        auto k = slot.key.load(std::memory_order_acquire);
+        if (k == key) {
+            auto result = slot.value.load(std::memory_order_acquire);
+            if (result != nullptr) return result;
+            break; // another thread is about to fill this slot
+        }
+        if (k == nullptr) break;
+    }
+    // slow path: lookup by name and remember the address of tinfo,
+    // note that a type might have more than one std::type_info instance
+    auto result = by_raw_name(raw_name(tinfo));
+    if (result == nullptr) return nullptr;
+    for (size_t i = 0; i < max_probes; ++i) {
+        auto& slot = m_by_tinfo[(hash + i) % tinfo_cache_size];
+        const std::type_info* expected = nullptr;
+        if (slot.key.compare_exchange_strong(expected, key)) {
+            slot.value.store(result, std::memory_order_release);
+            break;
+        }
+        if (expected == key) break;
+    }
+    return result;
+}
+
 bool uniform_type_info_map::insert(const std::set<std::string>& raw_names,
                                    uniform_type_info* what) {
     if (m_by_uname.count(what->name()) > 0) {
         delete what;
         return false;
     }
+    if (m_next_id >= max_types) {
+        delete what;
+        throw std::runtime_error("too many announced types");
+    }
     m_by_uname.insert(std::make_pair(what->name(), what));
+    what->m_id = m_next_id++;
+    auto& chunk = m_by_id[what->m_id / id_chunk_size];
+    if (chunk.load() == nullptr) {
+        auto slots = new id_slot[id_chunk_size];
+        for (size_t i = 0; i < id_chunk_size; ++i) {
+            slots[i].store(nullptr, std::memory_order_relaxed);
+        }
+        chunk.store(slots, std::memory_order_release);
+    }
+    chunk.load()[what->m_id % id_chunk_size].store(what,
+                                                   std::memory_order_release);
     for (auto& plain_name : raw_names) {
         if (!m_by_rname.insert(std::make_pair(plain_name, what)).second) {
             std::string error_str = plain_name;
@@ -672,15 +775,78 @@ bool uniform_type_info_map::insert(const std::set<std::string>& raw_names,
             throw std::runtime_error(error_str);
         }
     }
+    // completes signatures of match expressions created before announcing what
+    insert_pending_signatures();
+    return true;
+}
+
+bool uniform_type_info_map::to_signature(const std::type_info* const* types,
+                                         size_t size,
+                                         signature_type& storage) const {
+    storage.clear();
+    storage.reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+        auto utype = by_raw_name(raw_name(*types[i]));
+        if (utype == nullptr) return false;
+        storage.push_back(utype);
+    }
     return true;
 }
 
+bool uniform_type_info_map::insert_signature(const std::type_info** types,
+                                             size_t size,
+                                             tuple_factory factory) {
+    signature_type signature;
+    std::lock_guard<util::shared_spinlock> guard(m_signatures_mtx);
+    if (to_signature(types, size, signature)) {
+        m_signatures.insert(std::make_pair(std::move(signature), factory));
+        return true;
+    }
+    m_pending_signatures.push_back(pending_signature{{types, types + size},
+                                                     factory});
+    return false;
+}
+
+void uniform_type_info_map::insert_pending_signatures() {
+    std::lock_guard<util::shared_spinlock> guard(m_signatures_mtx);
+    signature_type signature;
+    auto i = m_pending_signatures.begin();
+    while (i != m_pending_signatures.end()) {
+        if (to_signature(i->types.data(), i->types.size(), signature)) {
+            m_signatures.insert(std::make_pair(std::move(signature),
+                                               i->factory));
+            i = m_pending_signatures.erase(i);
+        }
+        else ++i;
+    }
+}
+
+tuple_factory uniform_type_info_map::signature_factory(const signature_type& signature) const {
+    util::shared_lock_guard<util::shared_spinlock> guard(m_signatures_mtx);
+    auto i = m_signatures.find(signature);
+    return (i != m_signatures.end()) ? i->second : nullptr;
+}
+
+bool register_tuple_signature(const std::type_info** types,
+                              size_t size,
+                              tuple_factory factory) {
+    return uti_map().insert_signature(types, size, factory);
+}
+
+tuple_factory tuple_signature_factory(const std::vector<const uniform_type_info*>& signature) {
+    return uti_map().signature_factory(signature);
+}
+
 std::vector<const uniform_type_info*> uniform_type_info_map::get_all() const {
     std::vector<const uniform_type_info*> result;
     result.reserve(m_by_uname.size());
     for (const uti_map_type::value_type& i : m_by_uname) {
         result.push_back(i.second);
     }
+    std::sort(result.begin(), result.end(),
+              [](const uniform_type_info* lhs, const uniform_type_info* rhs) {
+                  return lhs->name() < rhs->name();
+              });
     return std::move(result);
 }
 
@@ -692,7 +858,8 @@ bool announce(const std::type_info& tinfo, uniform_type_info* utype) {
     return detail::uti_map().insert({detail::raw_name(tinfo)}, utype);
 }
 
-uniform_type_info::uniform_type_info(const std::string& str) : m_name(str) { }
+uniform_type_info::uniform_type_info(const std::string& str)
+: m_name(str), m_id(std::numeric_limits<std::uint32_t>::max()) { }
 
 uniform_type_info::~uniform_type_info() { }
 
@@ -718,7 +885,7 @@ object uniform_type_info::create() const {
 }
 
 const uniform_type_info* uniform_type_info::from(const std::type_info& tinf) {
-    auto result = detail::uti_map().by_raw_name(detail::raw_name(tinf));
+    auto result = detail::uti_map().by_type_info(tinf);
     if (result == nullptr) {
         std::string error = "uniform_type_info::by_type_info(): ";
         error += detail::to_uniform_name(tinf);
@@ -736,6 +903,14 @@ const uniform_type_info* uniform_type_info::from(const std::string& name) {
     return result;
 }
 
+const uniform_type_info* uniform_type_info::from(std::uint32_t type_id) {
+    auto result = detail::uti_map().by_id(type_id);
+    if (result == nullptr) {
+        throw std::runtime_error("unknown type id: " + std::to_string(type_id));
+    }
+    return result;
+}
+
 object uniform_type_info::deserialize(deserializer* from) const {
     auto ptr = new_instance();
     deserialize(ptr, from);
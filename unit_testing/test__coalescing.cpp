@@ -0,0 +1,148 @@
+#include <thread>
+#include <string>
+#include <cstring>
+#include <sstream>
+#include <iostream>
+
+#include "test.hpp"
+#include "cppa/cppa.hpp"
+#include "cppa/exception.hpp"
+
+using namespace std;
+using namespace cppa;
+
+namespace {
+
+// the client never flushes due to the delay during this test
+constexpr auto long_delay = chrono::seconds(60);
+
+// receives num messages {atom("msg"), i} in order and returns their sender
+actor_ptr receive_batch(int& errors, int num) {
+    actor_ptr sender;
+    int expected = 0;
+    int i = 0;
+    receive_for(i, num) (
+        on(atom("msg"), arg_match) >> [&](int value) {
+            if (value != expected) {
+                cerr << "expected " << expected << ", found " << value << endl;
+                ++errors;
+            }
+            ++expected;
+            sender = self->last_sender();
+        },
+        after(chrono::seconds(10)) >> [&] {
+            cerr << "timeout; received " << expected << " messages" << endl;
+            ++errors;
+            i = num - 1;
+        }
+    );
+    return sender;
+}
+
+void send_batch(const actor_ptr& server, int num) {
+    for (int i = 0; i < num; ++i) send(server, atom("msg"), i);
+}
+
+// waits until the server has received the current batch
+void await_ack() {
+    receive (
+        on(atom("ack")) >> [] { }
+    );
+}
+
+int client_part(uint16_t port) {
+    CPPA_TEST(test__coalescing_client_part);
+    // nothing is written before 1mb or 1000 messages are buffered
+    set_coalescing_policy({1024 * 1024, 1000, long_delay});
+    auto server = remote_actor("localhost", port);
+    // explicit flush
+    send_batch(server, 10);
+    flush_remote(server);
+    await_ack();
+    // flush on message count
+    set_coalescing_policy({1024 * 1024, 5, long_delay});
+    send_batch(server, 10);
+    await_ack();
+    // flush on timeout
+    set_coalescing_policy({1024 * 1024, 1000, chrono::milliseconds(2)});
+    send_batch(server, 10);
+    await_ack();
+    // flush on size
+    set_coalescing_policy({64, 1000, long_delay});
+    send(server, atom("msg"), 0, string(128, 'x'));
+    await_ack();
+    send(server, atom("farewell"));
+    flush_remote(server);
+    shutdown();
+    return CPPA_TEST_RESULT;
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        auto vec = split(argv[1], '=');
+        if (vec.size() != 2 || vec[0] != "port") {
+            cerr << "usage: " << argv[0] << " [port=<num>]" << endl;
+            return 1;
+        }
+        return client_part(static_cast<uint16_t>(stoi(vec[1])));
+    }
+    CPPA_TEST(test__coalescing);
+    uint16_t port = 4242;
+    bool success = false;
+    do {
+        try {
+            publish(self, port, "127.0.0.1");
+            success = true;
+        }
+        catch (bind_failure&) {
+            // try next port
+            ++port;
+        }
+    }
+    while (!success);
+    ostringstream oss;
+    oss << argv[0] << " port=" << port;
+    // execute client_part() in a separate process,
+    // connected via localhost socket
+    thread child{[&oss] {
+        string cmdstr = oss.str();
+        if (system(cmdstr.c_str()) != 0) {
+            cerr << "FATAL: command \"" << cmdstr << "\" failed!" << endl;
+            abort();
+        }
+    }};
+    cout << "test flush_remote" << endl;
+    auto client = receive_batch(cppa_ts.error_count, 10);
+    if (!client) {
+        CPPA_ERROR("no message received from client");
+        abort();
+    }
+    send(client, atom("ack"));
+    cout << "test flush on message count" << endl;
+    receive_batch(cppa_ts.error_count, 10);
+    send(client, atom("ack"));
+    cout << "test flush on timeout" << endl;
+    receive_batch(cppa_ts.error_count, 10);
+    send(client, atom("ack"));
+    cout << "test flush on size" << endl;
+    receive (
+        on(atom("msg"), 0, arg_match) >> [&](const string& str) {
+            CPPA_CHECK_EQUAL(128, str.size());
+        },
+        after(chrono::seconds(10)) >> [&] {
+            CPPA_ERROR("timeout while waiting for a large message");
+        }
+    );
+    send(client, atom("ack"));
+    receive (
+        on(atom("farewell")) >> [] { },
+        after(chrono::seconds(10)) >> [&] {
+            CPPA_ERROR("timeout while waiting for farewell");
+        }
+    );
+    child.join();
+    shutdown();
+    return CPPA_TEST_RESULT;
+}
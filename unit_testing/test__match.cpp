@@ -9,6 +9,8 @@
 #include "cppa/to_string.hpp"
 #include "cppa/guard_expr.hpp"
 
+#include "cppa/detail/object_array.hpp"
+
 using namespace std;
 using namespace cppa;
 
@@ -391,5 +393,44 @@ int main() {
 
     cout << "success: " << success << endl;
 
+    // dispatch on type token and leading atom
+    int dispatched = 0;
+    auto dispatch = (
+        on(atom("a")) >> [&] { dispatched = 1; },
+        on(atom("b")) >> [&] { dispatched = 2; },
+        on(atom("a"), arg_match) >> [&](int) { dispatched = 3; },
+        on(atom("b"), arg_match) >> [&](int) { dispatched = 4; },
+        on<atom_value, int>() >> [&](atom_value, int) { dispatched = 5; },
+        on<int>() >> [&](int) { dispatched = 6; },
+        on<float>() >> [&](float) { dispatched = 7; },
+        on<double>() >> [&](double) { dispatched = 8; }
+    );
+    // repeat to run both into uncached and cached entries
+    for (int i = 0; i < 2; ++i) {
+        dispatched = 0;
+        CPPA_CHECK(dispatch(make_any_tuple(atom("a"))) && dispatched == 1);
+        CPPA_CHECK(dispatch(make_any_tuple(atom("b"))) && dispatched == 2);
+        CPPA_CHECK(!dispatch(make_any_tuple(atom("c"))));
+        CPPA_CHECK(dispatch(make_any_tuple(atom("a"), 1)) && dispatched == 3);
+        CPPA_CHECK(dispatch(make_any_tuple(atom("b"), 1)) && dispatched == 4);
+        CPPA_CHECK(dispatch(make_any_tuple(atom("c"), 1)) && dispatched == 5);
+        CPPA_CHECK(dispatch(make_any_tuple(1)) && dispatched == 6);
+        CPPA_CHECK(dispatch(make_any_tuple(1.f)) && dispatched == 7);
+        CPPA_CHECK(dispatch(make_any_tuple(1.0)) && dispatched == 8);
+        CPPA_CHECK(!dispatch(make_any_tuple(1, 2)));
+        CPPA_CHECK(dispatch(atom("b"), 1) && dispatched == 4);
+    }
+    // dynamically typed tuples select candidates by their leading atom
+    auto dynamic_tuple = [](atom_value what, int value) -> any_tuple {
+        auto result = new detail::object_array;
+        result->push_back(object::from(what));
+        result->push_back(object::from(value));
+        return any_tuple{result};
+    };
+    dispatched = 0;
+    CPPA_CHECK(dispatch(dynamic_tuple(atom("a"), 1)) && dispatched == 3);
+    CPPA_CHECK(dispatch(dynamic_tuple(atom("b"), 1)) && dispatched == 4);
+    CPPA_CHECK(dispatch(dynamic_tuple(atom("c"), 1)) && dispatched == 5);
+
     return CPPA_TEST_RESULT;
 }
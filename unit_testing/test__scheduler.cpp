@@ -0,0 +1,118 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <iostream>
+
+#include "test.hpp"
+
+#include "cppa/on.hpp"
+#include "cppa/cppa.hpp"
+#include "cppa/actor.hpp"
+#include "cppa/scheduler.hpp"
+#include "cppa/exit_reason.hpp"
+#include "cppa/scheduled_actor.hpp"
+#include "cppa/event_based_actor.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace cppa;
+
+namespace {
+
+// answers each {ping} with a {ping} to its buddy, i.e., forever
+struct ping_ponger : event_based_actor {
+    actor_ptr m_buddy;
+    void init() {
+        become (
+            on(atom("buddy"), arg_match) >> [=](const actor_ptr& buddy) {
+                m_buddy = buddy;
+            },
+            on(atom("ping")) >> [=]() {
+                send(m_buddy, atom("ping"));
+            }
+        );
+    }
+};
+
+struct echo : event_based_actor {
+    void init() {
+        become (
+            on(atom("hello")) >> [=]() {
+                reply(atom("hello"));
+            }
+        );
+    }
+};
+
+} // namespace <anonymous>
+
+int main() {
+    CPPA_TEST(test__scheduler);
+    // a single worker runs all event-based actors and
+    // at most two threads run all blocking I/O actors
+    set_default_scheduler(1, 2);
+    cout << "test that actors ping-ponging forever do not "
+            "starve other actors" << endl;
+    auto a = spawn<ping_ponger>();
+    auto b = spawn<ping_ponger>();
+    send(a, atom("buddy"), b);
+    send(b, atom("buddy"), a);
+    send(a, atom("ping"));
+    auto c = spawn<echo>();
+    send(c, atom("hello"));
+    int i = 0;
+    receive_for(i, 10) (
+        on(atom("hello")) >> [&]() {
+            if (i < 9) send(c, atom("hello"));
+        },
+        after(std::chrono::seconds(10)) >> [&]() {
+            CPPA_ERROR("echo actor was not scheduled");
+            i = 9;
+        }
+    );
+    for (auto& whom : {a, b, c}) {
+        send(whom, atom("EXIT"), exit_reason::user_defined);
+    }
+    await_all_others_done();
+    cout << "test spawn_on_node" << endl;
+    // node 0 exists on any machine, other indexes wrap around
+    for (int node : {0, 1, 7}) {
+        auto e = spawn_on_node<echo>(node);
+        auto sptr = dynamic_cast<scheduled_actor*>(e.get());
+        CPPA_CHECK(sptr != nullptr);
+        if (sptr) {
+            CPPA_CHECK_EQUAL(node, sptr->node_affinity());
+        }
+        send(e, atom("hello"));
+        receive (
+            on(atom("hello")) >> []() { },
+            after(std::chrono::seconds(10)) >> [&]() {
+                CPPA_ERROR("actor on node " << node << " was not scheduled");
+            }
+        );
+        send(e, atom("EXIT"), exit_reason::user_defined);
+    }
+    await_all_others_done();
+    cout << "test that blocking I/O actors beyond the maximum "
+            "number of threads are queued" << endl;
+    std::atomic<int> running{0};
+    std::atomic<int> max_running{0};
+    std::atomic<int> done{0};
+    for (int i = 0; i < 6; ++i) {
+        spawn<blocking_io>([&]() {
+            auto value = ++running;
+            auto prev = max_running.load();
+            while (value > prev
+                   && !max_running.compare_exchange_weak(prev, value)) { }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            --running;
+            ++done;
+        });
+    }
+    await_all_others_done();
+    CPPA_CHECK_EQUAL(6, done.load());
+    CPPA_CHECK(max_running.load() <= 2);
+    shutdown();
+    return CPPA_TEST_RESULT;
+}
@@ -26,6 +26,7 @@
 
 #include "test.hpp"
 
+#include "cppa/on.hpp"
 #include "cppa/self.hpp"
 #include "cppa/cow_tuple.hpp"
 #include "cppa/any_tuple.hpp"
@@ -109,6 +110,25 @@ bool operator!=(const struct_c& lhs, const struct_c& rhs) {
     return !(lhs == rhs);
 }
 
+struct struct_d {
+    uint16_t a;
+    int64_t b;
+    string c;
+};
+
+bool operator==(const struct_d& lhs, const struct_d& rhs) {
+    return lhs.a == rhs.a && lhs.b == rhs.b && lhs.c == rhs.c;
+}
+
+// announced after a match expression using it was created
+struct late_struct {
+    int value;
+};
+
+bool operator==(const late_struct& lhs, const late_struct& rhs) {
+    return lhs.value == rhs.value;
+}
+
 static const char* msg1str = u8R"__({ @i32 ( 42 ), "Hello \"World\"!" })__";
 
 struct raw_struct {
@@ -223,6 +243,71 @@ int main() {
     }
     catch (exception& e) { CPPA_ERROR(to_verbose_string(e)); }
 
+    try {
+        // a match expression makes its signatures known to the deserializer
+        bool invoked = false;
+        auto mexpr = (on<uint32_t, string>() >> [&](uint32_t, const string&) {
+            invoked = true;
+        });
+        util::buffer wr_buf;
+        binary_serializer bs(&wr_buf, &addressing);
+        bs << atuple1;
+        binary_deserializer bd(wr_buf.data(), wr_buf.size(), &addressing);
+        any_tuple atuple2;
+        uniform_typeid<any_tuple>()->deserialize(&atuple2, &bd);
+        typedef detail::static_type_list<uint32_t, string> signature;
+        CPPA_CHECK(atuple2.type_token() == signature::list);
+        CPPA_CHECK(mexpr(atuple2));
+        CPPA_CHECK(invoked);
+        auto opt = tuple_cast<uint32_t, string>(atuple2);
+        CPPA_CHECK(opt.valid());
+        if (opt.valid()) {
+            CPPA_CHECK_EQUAL(get<0>(*opt), 42);
+            CPPA_CHECK_EQUAL(get<1>(*opt), "foo");
+        }
+    }
+    catch (exception& e) { CPPA_ERROR(to_verbose_string(e)); }
+
+    try {
+        // signatures of a match expression created before its types
+        // are announced become known once all types are announced
+        auto mexpr = (on<late_struct, uint32_t>() >> [](const late_struct&,
+                                                       uint32_t) { });
+        announce<late_struct>(&late_struct::value);
+        util::buffer wr_buf;
+        binary_serializer bs(&wr_buf, &addressing);
+        bs << make_any_tuple(late_struct{1}, uint32_t{2});
+        binary_deserializer bd(wr_buf.data(), wr_buf.size(), &addressing);
+        any_tuple atuple2;
+        uniform_typeid<any_tuple>()->deserialize(&atuple2, &bd);
+        typedef detail::static_type_list<late_struct, uint32_t> signature;
+        CPPA_CHECK(atuple2.type_token() == signature::list);
+        CPPA_CHECK(mexpr(atuple2));
+    }
+    catch (exception& e) { CPPA_ERROR(to_verbose_string(e)); }
+
+    try {
+        // vectors of integers are written as a single memory block
+        vector<uint32_t> vec1(10000);
+        for (size_t i = 0; i < vec1.size(); ++i) vec1[i] = i * 3;
+        util::buffer wr_buf;
+        binary_serializer bs(&wr_buf, &addressing);
+        bs << vec1;
+        auto tname = uniform_typeid<vector<uint32_t>>()->name();
+        CPPA_CHECK_EQUAL(wr_buf.size(), sizeof(uint32_t) + tname.size()
+                                        + sizeof(uint32_t)
+                                        + vec1.size() * sizeof(uint32_t));
+        binary_deserializer bd(wr_buf.data(), wr_buf.size(), &addressing);
+        object obj;
+        bd >> obj;
+        CPPA_CHECK(get<vector<uint32_t>>(obj) == vec1);
+        // string serialization still uses element-wise output
+        vector<uint32_t> vec2{1, 2, 3};
+        auto vec2_str = detail::to_string_impl(vec2);
+        CPPA_CHECK(get<vector<uint32_t>>(from_string(vec2_str)) == vec2);
+    }
+    catch (exception& e) { CPPA_ERROR(to_verbose_string(e)); }
+
     try {
         any_tuple msg1 = cppa::make_cow_tuple(42, string("Hello \"World\"!"));
         auto msg1_tostring = to_string(msg1);
@@ -333,5 +418,48 @@ int main() {
         // verify result of serialization / deserialization
         CPPA_CHECK(c1 == c2);
     }
+    { // test serializers / deserializers with flat struct_d
+        announce<struct_d>(&struct_d::a, &struct_d::b, &struct_d::c);
+        struct_d d1{42, -123456789012, "hello world"};
+        util::buffer wr_buf;
+        binary_serializer bs(&wr_buf, &addressing);
+        bs << d1;
+        // must produce the same bytes as the generic member-wise path
+        util::buffer expected_buf;
+        binary_serializer ebs(&expected_buf, &addressing);
+        ebs.begin_object("struct_d");
+        ebs.write_value(d1.a);
+        ebs.write_value(d1.b);
+        ebs.write_value(d1.c);
+        ebs.end_object();
+        CPPA_CHECK_EQUAL(wr_buf.size(), expected_buf.size());
+        CPPA_CHECK(memcmp(wr_buf.data(),
+                          expected_buf.data(),
+                          wr_buf.size()) == 0);
+        binary_deserializer bd(wr_buf.data(), wr_buf.size(), &addressing);
+        object res;
+        bd >> res;
+        CPPA_CHECK_EQUAL(res.type()->name(), "struct_d");
+        CPPA_CHECK(get<struct_d>(res) == d1);
+        // string serialization uses the generic path
+        auto d1str = "struct_d ( 42, -123456789012, \"hello world\" )";
+        CPPA_CHECK_EQUAL(to_string(object::from(d1)), d1str);
+        CPPA_CHECK(get<struct_d>(from_string(d1str)) == d1);
+        // a string size exceeding the input must not be trusted
+        util::buffer bad_buf;
+        binary_serializer bad_bs(&bad_buf, &addressing);
+        bad_bs.begin_object("struct_d");
+        bad_bs.write_value(d1.a);
+        bad_bs.write_value(d1.b);
+        bad_bs.write_value(std::numeric_limits<uint32_t>::max());
+        bad_bs.end_object();
+        binary_deserializer bad_bd(bad_buf.data(), bad_buf.size(), &addressing);
+        try {
+            object bad_res;
+            bad_bd >> bad_res;
+            CPPA_ERROR("deserialized a string exceeding the input");
+        }
+        catch (std::out_of_range&) { }
+    }
     return CPPA_TEST_RESULT;
 }
@@ -1,6 +1,8 @@
 #define CPPA_VERBOSE_CHECK
 
 #include <stack>
+#include <thread>
+#include <vector>
 #include <chrono>
 #include <iostream>
 #include <functional>
@@ -14,6 +16,7 @@
 #include "cppa/factory.hpp"
 #include "cppa/scheduler.hpp"
 #include "cppa/sb_actor.hpp"
+#include "cppa/typed_actor.hpp"
 #include "cppa/to_string.hpp"
 #include "cppa/exit_reason.hpp"
 #include "cppa/event_based_actor.hpp"
@@ -297,6 +300,64 @@ struct simple_mirror : sb_actor<simple_mirror> {
 
 };
 
+// mirrors all messages and quits on {'EXIT', reason}
+struct batch_mirror : sb_actor<batch_mirror> {
+
+    behavior init_state = (
+        on(atom("EXIT"), arg_match) >> [](std::uint32_t reason) {
+            self->quit(reason);
+        },
+        others() >> []() {
+            reply_tuple(self->last_dequeued());
+        }
+    );
+
+};
+
+// sums up three integers and replies the result to {get}
+class co_adder : public coroutine_actor {
+
+    int m_sum;
+    int m_remaining;
+
+    void run() {
+        CPPA_CO_BEGIN();
+        m_sum = 0;
+        for (m_remaining = 3; m_remaining > 0; --m_remaining) {
+            CPPA_CO_RECEIVE (
+                on_arg_match >> [=](int value) {
+                    m_sum += value;
+                }
+            );
+        }
+        CPPA_CO_RECEIVE (
+            on(atom("get")) >> [=]() {
+                reply(m_sum);
+            }
+        );
+        CPPA_CO_END();
+    }
+
+};
+
+// receives two strings and replies their concatenation; both receive
+// statements share one line to check that each gets its own resume point
+#define CO_RECEIVE_TWICE(first, second)                                       \
+    CPPA_CO_RECEIVE(on_arg_match >> first); CPPA_CO_RECEIVE(on_arg_match >> second)
+
+class co_concat : public coroutine_actor {
+
+    string m_str;
+
+    void run() {
+        CPPA_CO_BEGIN();
+        CO_RECEIVE_TWICE([=](const string& str) { m_str = str; },
+                         [=](const string& str) { reply(m_str + str); });
+        CPPA_CO_END();
+    }
+
+};
+
 int main() {
     CPPA_TEST(test__spawn);
 
@@ -333,6 +394,106 @@ int main() {
     await_all_others_done();
     CPPA_IF_VERBOSE(cout << "ok" << endl);
 
+    CPPA_IF_VERBOSE(cout << "test blocking I/O actors ... " << flush);
+    for (int wave = 0; wave < 2; ++wave) {
+        // all actors block concurrently, i.e., the pool has to grow
+        vector<actor_ptr> io_actors;
+        for (int i = 0; i < 8; ++i) {
+            io_actors.push_back(spawn<blocking_io>([]() {
+                receive (
+                    on_arg_match >> [](int value) {
+                        this_thread::sleep_for(chrono::milliseconds(10));
+                        reply(value * 2);
+                    }
+                );
+            }));
+        }
+        for (int i = 0; i < 8; ++i) send(io_actors[i], i);
+        int sum = 0;
+        for (int i = 0; i < 8; ++i) {
+            receive (
+                on_arg_match >> [&](int value) { sum += value; },
+                after(chrono::seconds(5)) >> [&]() {
+                    CPPA_ERROR("blocking I/O actor did not reply");
+                }
+            );
+        }
+        CPPA_CHECK_EQUAL(sum, 56);
+        await_all_others_done();
+    }
+    CPPA_IF_VERBOSE(cout << "ok" << endl);
+
+    CPPA_IF_VERBOSE(cout << "test spawn_batch ... " << flush);
+    auto mirrors = spawn_batch<batch_mirror>(100);
+    CPPA_CHECK_EQUAL(mirrors.size(), (size_t) 100);
+    for (size_t i = 0; i < mirrors.size(); ++i) {
+        send(mirrors[i], static_cast<int>(i));
+    }
+    int mirrored_sum = 0;
+    for (size_t i = 0; i < mirrors.size(); ++i) {
+        receive (
+            on_arg_match >> [&](int value) { mirrored_sum += value; },
+            after(chrono::seconds(5)) >> [&]() {
+                CPPA_ERROR("batch-spawned actor did not reply");
+            }
+        );
+    }
+    CPPA_CHECK_EQUAL(mirrored_sum, 4950);
+    // monitor all mirrors, but stop monitoring every second one
+    for (auto& m : mirrors) self->monitor(m);
+    for (size_t i = 1; i < mirrors.size(); i += 2) self->demonitor(mirrors[i]);
+    for (auto& m : mirrors) send(m, atom("EXIT"), exit_reason::user_defined);
+    size_t down_messages = 0;
+    receive_for(down_messages, mirrors.size() / 2) (
+        on(atom("DOWN"), exit_reason::user_defined) >> []() { },
+        after(chrono::seconds(5)) >> [&]() {
+            CPPA_ERROR("timeout while waiting for DOWN messages");
+        }
+    );
+    await_all_others_done();
+    // no DOWN messages from demonitored actors
+    receive (
+        on(atom("DOWN"), arg_match) >> [&](uint32_t) {
+            CPPA_ERROR("received DOWN message from demonitored actor");
+        },
+        after(chrono::seconds(0)) >> []() { }
+    );
+    CPPA_IF_VERBOSE(cout << "ok" << endl);
+
+    CPPA_IF_VERBOSE(cout << "test order of attachables ... " << flush);
+    auto observed = spawn<simple_mirror>();
+    vector<int> exit_order;
+    for (int i = 0; i < 5; ++i) {
+        observed->attach_functor([i, &exit_order](uint32_t) {
+            exit_order.push_back(i);
+        });
+        self->monitor(observed);
+        self->monitor(observed);
+    }
+    // leaves gaps between the functors and compacts the attachables
+    for (int i = 0; i < 10; ++i) self->demonitor(observed);
+    send(observed, atom("EXIT"), exit_reason::user_defined);
+    await_all_others_done();
+    CPPA_CHECK((exit_order == vector<int>{0, 1, 2, 3, 4}));
+    receive (
+        on(atom("DOWN"), arg_match) >> [&](uint32_t) {
+            CPPA_ERROR("received DOWN message from demonitored actor");
+        },
+        after(chrono::seconds(0)) >> []() { }
+    );
+    CPPA_IF_VERBOSE(cout << "ok" << endl);
+
+    CPPA_IF_VERBOSE(cout << "test mirror on NUMA node 0 ... " << flush);
+    // node 0 exists on any machine
+    auto node_mirror = spawn_on_node<simple_mirror>(0);
+    for (int i = 0; i < 10; ++i) {
+        send(node_mirror, i);
+        receive(on(i) >> []() { });
+    }
+    send(node_mirror, atom("EXIT"), exit_reason::user_defined);
+    await_all_others_done();
+    CPPA_IF_VERBOSE(cout << "ok" << endl);
+
     CPPA_IF_VERBOSE(cout << "test echo actor ... " << flush);
     auto mecho = spawn(echo_actor);
     send(mecho, "hello echo");
@@ -531,6 +692,97 @@ int main() {
         after(chrono::milliseconds(5)) >> []() { }
     );
 
+    CPPA_IF_VERBOSE(cout << "test typed actor ... " << flush);
+    typed_actor<int (int, int), size_t (string), void (atom_value)> adder =
+    spawn_typed(
+        [](int a, int b) {
+            return a + b;
+        },
+        [](const string& str) {
+            return str.size();
+        },
+        [](atom_value) {
+            self->quit();
+        }
+    );
+    send(adder, 1, 2);
+    receive (
+        on_arg_match >> [&](int res) {
+            CPPA_CHECK_EQUAL(res, 3);
+        }
+    );
+    receive_response (sync_send(adder, 20, 22)) (
+        on_arg_match >> [&](int res) {
+            CPPA_CHECK_EQUAL(res, 42);
+        },
+        after(chrono::seconds(5)) >> [&]() {
+            CPPA_ERROR("timeout during receive_response");
+        }
+    );
+    // messages matching none of the signatures are never dispatched
+    send(adder.address(), 1.0f);
+    send(adder, "foo");
+    receive (
+        on_arg_match >> [&](size_t len) {
+            CPPA_CHECK_EQUAL(len, (size_t) 3);
+        }
+    );
+    // alternating types are dispatched to their handlers from the cache
+    for (int i = 0; i < 3; ++i) {
+        send(adder, i, i);
+        send(adder.address(), 1.0f);
+        send(adder, "ab");
+    }
+    int typed_results = 0;
+    int expected_sum = 0;
+    receive_for(typed_results, 6) (
+        on_arg_match >> [&](int res) {
+            CPPA_CHECK_EQUAL(res, expected_sum);
+            expected_sum += 2;
+        },
+        on_arg_match >> [&](size_t len) {
+            CPPA_CHECK_EQUAL(len, (size_t) 2);
+        },
+        after(chrono::seconds(5)) >> [&]() {
+            CPPA_ERROR("timeout while waiting for typed results");
+            typed_results = 5;
+        }
+    );
+    send(adder, atom("quit"));
+    await_all_others_done();
+    CPPA_IF_VERBOSE(cout << "ok" << endl);
+
+    CPPA_IF_VERBOSE(cout << "test coroutine actor ... " << flush);
+    auto co = spawn<co_adder>();
+    // {get} is not matched until all three integers were received
+    send(co, atom("get"));
+    send(co, 1);
+    send(co, 2);
+    send(co, 3);
+    receive (
+        on_arg_match >> [&](int res) {
+            CPPA_CHECK_EQUAL(res, 6);
+        },
+        after(chrono::seconds(5)) >> [&]() {
+            CPPA_ERROR("timeout while waiting for coroutine actor");
+        }
+    );
+    // the actor quits after reaching CPPA_CO_END()
+    await_all_others_done();
+    auto cc = spawn<co_concat>();
+    send(cc, "foo");
+    send(cc, "bar");
+    receive (
+        on_arg_match >> [&](const string& res) {
+            CPPA_CHECK_EQUAL(res, "foobar");
+        },
+        after(chrono::seconds(5)) >> [&]() {
+            CPPA_ERROR("timeout while waiting for coroutine actor");
+        }
+    );
+    await_all_others_done();
+    CPPA_IF_VERBOSE(cout << "ok" << endl);
+
     auto inflater = factory::event_based(
         [](string*, actor_ptr* receiver) {
             self->become(
@@ -30,6 +30,7 @@
 #include "cppa/detail/types_array.hpp"
 #include "cppa/detail/value_guard.hpp"
 #include "cppa/detail/object_array.hpp"
+#include "cppa/detail/pooled_memory.hpp"
 
 using std::cout;
 using std::endl;
@@ -131,6 +132,34 @@ struct dummy_receiver : event_based_actor {
     }
 };
 
+struct dummy_forwarder : event_based_actor {
+    actor_ptr m_buddy;
+    dummy_forwarder(actor_ptr buddy) : m_buddy(std::move(buddy)) { }
+    void init() {
+        become(
+            on_arg_match >> [=](const expensive_copy_struct&) {
+                forward_to(m_buddy);
+                quit();
+            }
+        );
+    }
+};
+
+// forwards a message and sends another message to the same receiver
+struct ordered_forwarder : event_based_actor {
+    actor_ptr m_buddy;
+    ordered_forwarder(actor_ptr buddy) : m_buddy(std::move(buddy)) { }
+    void init() {
+        become(
+            others() >> [=] {
+                forward_to(m_buddy);
+                send(m_buddy, atom("after"));
+                quit();
+            }
+        );
+    }
+};
+
 int main() {
     CPPA_TEST(test__tuple);
 
@@ -393,6 +422,19 @@ int main() {
         }
     }
 
+    cout << "check pooled allocation of tuples" << endl;
+    {
+        // warm up thread cache
+        { auto tmp = make_any_tuple(std::string("hello"), 42); }
+        auto before = detail::pooled_memory::statistics();
+        for (int i = 0; i < 100; ++i) {
+            auto tmp = make_any_tuple(std::string("hello"), i);
+            CPPA_CHECK_EQUAL(tmp.get_as<int>(1), i);
+        }
+        auto after = detail::pooled_memory::statistics();
+        CPPA_CHECK_EQUAL(before.system_allocations, after.system_allocations);
+    }
+
     cout << "check correct tuple move operations" << endl;
     send(spawn<dummy_receiver>(), expensive_copy_struct());
     receive (
@@ -401,6 +443,32 @@ int main() {
         }
     );
     CPPA_CHECK_EQUAL(s_expensive_copies, (size_t) 0);
+    cout << "check that forward_to moves its message" << endl;
+    auto fwd = spawn<dummy_forwarder>(spawn<dummy_receiver>());
+    receive_response (sync_send(fwd, expensive_copy_struct())) (
+        on_arg_match >> [&](expensive_copy_struct& ecs) {
+            CPPA_CHECK_EQUAL(ecs.value, 42);
+        },
+        after(std::chrono::seconds(10)) >> [&]() {
+            CPPA_ERROR("timeout during receive_response");
+        }
+    );
+    CPPA_CHECK_EQUAL(s_expensive_copies, (size_t) 0);
+    cout << "check that forward_to keeps the order of messages" << endl;
+    send(spawn<ordered_forwarder>(self), atom("forwarded"));
+    int i = 0;
+    receive_for(i, 2) (
+        on(atom("forwarded")) >> [&] {
+            CPPA_CHECK_EQUAL(i, 0);
+        },
+        on(atom("after")) >> [&] {
+            CPPA_CHECK_EQUAL(i, 1);
+        },
+        after(std::chrono::seconds(10)) >> [&] {
+            CPPA_ERROR("timeout while waiting for forwarded messages");
+            i = 1;
+        }
+    );
     await_all_others_done();
     shutdown();
     return CPPA_TEST_RESULT;
@@ -66,6 +66,18 @@ int main() {
                                + int_val(announce3)
                                + int_val(announce4);
     CPPA_CHECK_EQUAL(successful_announces, 1);
+    // type IDs are dense and match their compile-time counterparts
+    CPPA_CHECK_EQUAL(uniform_typeid<foo>()->id(),
+                     (std::uint32_t) detail::builtin_types::size);
+    CPPA_CHECK(uniform_type_info::from(uniform_typeid<foo>()->id())
+               == uniform_typeid<foo>());
+    CPPA_CHECK_EQUAL(uniform_typeid<std::int32_t>()->id(), type_id<int>());
+    CPPA_CHECK_EQUAL(uniform_typeid<std::uint64_t>()->id(),
+                     type_id<unsigned long long>());
+    CPPA_CHECK_EQUAL(uniform_typeid<atom_value>()->id(), type_id<atom_value>());
+    CPPA_CHECK(uniform_typeid<any_tuple>() == uniform_typeid(typeid(any_tuple)));
+    CPPA_CHECK(uniform_typeid<std::uint16_t>()->equals(typeid(std::uint16_t)));
+    CPPA_CHECK(!uniform_typeid<std::uint16_t>()->equals(typeid(std::int16_t)));
     // these types (and only those) are present if
     // the uniform_type_info implementation is correct
     std::set<std::string> expected = {
@@ -75,6 +87,7 @@ int main() {
         "@u8", "@u16", "@u32", "@u64",    // unsigned integer names
         "@str", "@u16str", "@u32str",     // strings
         "@strmap",                        // string containers
+        "@u32vec",                        // std::vector<std::uint32_t>
         "float", "double", "long double", // floating points
         "@0",                             // cppa::util::void_type
         // default announced cppa types
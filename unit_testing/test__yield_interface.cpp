@@ -35,6 +35,41 @@ struct pseudo_worker {
 
 void coroutine(void* worker) { (*reinterpret_cast<pseudo_worker*>(worker))(); }
 
+// records an address on the stack of a fiber
+struct stack_probe {
+    fiber* caller;
+    fiber* callee;
+    size_t touched_bytes;
+    void* address;
+};
+
+void touch_stack(size_t bytes) {
+    char buf[192 * 1024];
+    memset(buf, 0xFF, bytes);
+    // keeps the compiler from optimizing buf away
+    volatile char c = buf[bytes - 1];
+    static_cast<void>(c);
+}
+
+void run_probe(void* ptr) {
+    auto probe = reinterpret_cast<stack_probe*>(ptr);
+    for (;;) {
+        char local;
+        probe->address = &local;
+        if (probe->touched_bytes > 0) touch_stack(probe->touched_bytes);
+        fiber::swap(*(probe->callee), *(probe->caller));
+    }
+}
+
+// runs a new fiber once and returns the address recorded on its stack
+void* probe_stack(stack_probe& probe, size_t stack_size, size_t bytes) {
+    fiber f(run_probe, &probe, stack_size);
+    probe.callee = &f;
+    probe.touched_bytes = bytes;
+    fiber::swap(*(probe.caller), f);
+    return probe.address;
+}
+
 int main() {
     CPPA_TEST(test__yield_interface);
 #   ifdef CPPA_DISABLE_CONTEXT_SWITCHING
@@ -56,6 +91,16 @@ int main() {
     CPPA_CHECK_EQUAL("yield_state::done", to_string(ys));
     CPPA_CHECK_EQUAL(10, worker.m_count);
     CPPA_CHECK_EQUAL(12, i);
+    // stacks of destroyed fibers are reused per size class
+    stack_probe probe{&fself, nullptr, 0, nullptr};
+    auto small_stack = probe_stack(probe, 0, 0);
+    CPPA_CHECK(small_stack == probe_stack(probe, 0, 0));
+    auto large_stack = probe_stack(probe, 200 * 1024, 160 * 1024);
+    CPPA_CHECK(large_stack != small_stack);
+    // pooled stacks are usable after their pages were released
+    CPPA_CHECK(large_stack == probe_stack(probe, 200 * 1024, 160 * 1024));
+    CPPA_CHECK(large_stack == probe_stack(probe, 256 * 1024, 160 * 1024));
+    CPPA_CHECK(small_stack == probe_stack(probe, 0, 0));
 #   endif
     return CPPA_TEST_RESULT;
 }